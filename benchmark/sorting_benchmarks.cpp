@@ -1,12 +1,18 @@
 #include <benchmark/benchmark.h>
+#include <compare>
+#include <cstdint>
 #include <cstdlib>
 #include <forward_list>
+#include <functional>
 #include <list>
 #include <memory>
 #include <random>
 #include <ranges>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "enranged/parallel_sorting.hpp"
 #include "enranged/sorting.hpp"
 
 #include "linked_list.hpp"  // from test
@@ -76,18 +82,95 @@ protected:
     return *range_;
   }
 
+  // Splits the test data into the given number of sorted shards, and
+  // returns them along with an empty list to merge them into
+  std::pair<T&, std::vector<T>&> rebuild_shards(::benchmark::State& state,
+                                                const size_t count) {
+    state.PauseTiming();
+    range_.reset();
+    shards_.clear();
+    memory_resource.reset();
+
+    std::vector<std::vector<int>> pieces(count);
+    for (size_t i = 0; i < size_t(state.range(0)); ++i)
+      pieces[i % count].push_back(test_vec[i]);
+
+    for (auto& piece : pieces) {
+      ranges::sort(piece);
+      shards_.emplace_back(piece.begin(), piece.end());
+    }
+    range_ = std::make_unique<T>();
+
+    benchmark::ClobberMemory();
+    state.ResumeTiming();
+
+    return { *range_, shards_ };
+  }
+
   void TearDown(const ::benchmark::State& state) {
     range_.reset();
+    shards_.clear();
   }
 
 private:
   std::unique_ptr<T> range_;
+  std::vector<T> shards_;
 };
 
 bool eq_rel(const int x, const int y) noexcept {
   return x >> 26 == y >> 26;
 }
 
+// 4096 equivalence classes for non-negative ints
+bool fine_eq_rel(const int x, const int y) noexcept {
+  return x >> 19 == y >> 19;
+}
+
+// The key giving the same classes as eq_rel
+int coarse_key(const int x) noexcept {
+  return x >> 26;
+}
+
+size_t bucket_of(const int x) noexcept {
+  return size_t(x >> 26);
+}
+
+// A projection leaving only 16 distinct keys
+int few_keys(const int x) noexcept {
+  return x >> 27;
+}
+
+// A projection costing more than the comparison itself (like parsing
+// or formatting the element would)
+uint32_t expensive_key(const int x) noexcept {
+  auto key = uint32_t(x);
+  for (int i = 0; i < 8; ++i) {
+    key^= key >> 16;
+    key*= 0x45d9f3bu;
+  }
+  return key;
+}
+
+// Runs every task in a new thread (there is no point in pooling for
+// the sizes we use)
+class thread_executor {
+public:
+  explicit thread_executor(const size_t threads) noexcept:
+    threads_(threads) {}
+
+  void execute(std::function<void()> task) {
+    workers_.emplace_back(std::move(task));
+  }
+
+  size_t max_concurrency() const noexcept {
+    return threads_;
+  }
+
+private:
+  size_t threads_;
+  std::vector<std::jthread> workers_;
+};
+
 BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merge_sort_list,
                             std::list<int, shuffled_allocator<int>>)
   (benchmark::State& state) {
@@ -110,6 +193,284 @@ BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bucket_sort_list,
   }
 }
 
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bucket_sort_three_way_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice(range, enranged::before_begin(range),
+                                 ranges::end(range),
+                                 std::compare_three_way{}, coarse_key);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bucket_sort_bucket_of_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice<32>(range,
+                                     enranged::before_begin(range),
+                                     ranges::end(range), bucket_of);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bucket_sort_many_buckets_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice<4096>(std::allocator<int>{}, range,
+                                       enranged::before_begin(range),
+                                       ranges::end(range), fine_eq_rel);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            bucket_sort_runtime_buckets_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice(4096, std::allocator<int>{}, range,
+                                 fine_eq_rel);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merging_bucket_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice(enranged::merging_bucket_sort_policy<>{},
+                                 range, enranged::before_begin(range),
+                                 ranges::end(range), fine_eq_rel);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merge_sort_expensive_key_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(range, enranged::before_begin(range),
+                                ranges::size(range), {}, expensive_key);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, key_caching_merge_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(enranged::key_caching_sort_policy<>{},
+                                range, enranged::before_begin(range),
+                                ranges::size(range), {}, expensive_key);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, network_merge_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(enranged::network_sort_policy<>{},
+                                range, enranged::before_begin(range),
+                                ranges::size(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, network_16_merge_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  using policy_t =
+    enranged::network_sort_policy<enranged::default_sort_policy, 16>;
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(policy_t{}, range,
+                                enranged::before_begin(range),
+                                ranges::size(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, prefetching_merge_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(enranged::prefetching_sort_policy<>{},
+                                range, enranged::before_begin(range),
+                                ranges::size(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, prefetching_bucket_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice(enranged::prefetching_sort_policy<>{},
+                                 range, enranged::before_begin(range),
+                                 ranges::end(range), eq_rel);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, radix_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::radix_sort_splice(range,
+                                enranged::before_begin(range),
+                                ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, msd_radix_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::msd_radix_sort_splice(range,
+                                    enranged::before_begin(range),
+                                    ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, buffered_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::buffered_sort_splice(std::allocator<int>{}, range,
+                                   enranged::before_begin(range),
+                                   ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            prefetching_buffered_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::buffered_sort_splice(enranged::prefetching_sort_policy<>{},
+                                   std::allocator<int>{}, range,
+                                   enranged::before_begin(range),
+                                   ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, partial_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::partial_sort_splice(range, enranged::before_begin(range),
+                                  state.range(0), state.range(1));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, nth_element_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::nth_element_splice(range, enranged::before_begin(range),
+                                 state.range(0), state.range(0) / 2);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, quick_sort_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::quick_sort_splice(range, enranged::before_begin(range),
+                                state.range(0));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, quick_sort_few_keys_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::quick_sort_splice(range, enranged::before_begin(range),
+                                state.range(0), {}, few_keys);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merge_sort_few_keys_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(range, enranged::before_begin(range),
+                                state.range(0), {}, few_keys);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            galloping_merge_sort_few_keys_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(enranged::galloping_sort_policy<>{},
+                                range, enranged::before_begin(range),
+                                state.range(0), {}, few_keys);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, counting_sort_few_keys_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::counting_sort_splice<16>(range, few_keys);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, group_by_few_keys_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    benchmark::DoNotOptimize(enranged::group_by_splice(range, few_keys));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merge_splice_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto [dst, shards] = this->rebuild_shards(state, state.range(1));
+    enranged::merge_splice(dst, shards);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merge_splice_two_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto [dst, shards] = this->rebuild_shards(state, 2);
+    enranged::merge_splice(shards[0], enranged::before_begin(shards[0]),
+                           ranges::end(shards[0]),
+                           shards[1], enranged::before_begin(shards[1]),
+                           ranges::end(shards[1]));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, std_merge_list,
+                            std::list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto [dst, shards] = this->rebuild_shards(state, state.range(1));
+    for (auto& shard : shards) dst.merge(shard);
+  }
+}
+
 BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, std_sort_list,
                             std::list<int, shuffled_allocator<int>>)
   (benchmark::State& state) {
@@ -130,6 +491,17 @@ BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, merge_sort_forward_list,
   }
 }
 
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bottom_up_merge_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(range,
+                                enranged::before_begin(range),
+                                ranges::end(range));
+  }
+}
+
 BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bucket_sort_forward_list,
                             std::forward_list<int, shuffled_allocator<int>>)
   (benchmark::State& state) {
@@ -141,6 +513,118 @@ BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, bucket_sort_forward_list,
   }
 }
 
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            prefetching_merge_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(enranged::prefetching_sort_policy<>{},
+                                range, enranged::before_begin(range),
+                                state.range(0));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            parallel_merge_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::merge_sort_splice(thread_executor(state.range(1)),
+                                range, enranged::before_begin(range),
+                                state.range(0));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            parallel_bucket_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::bucket_sort_splice(thread_executor(state.range(1)),
+                                 range, enranged::before_begin(range),
+                                 ranges::end(range), eq_rel);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, radix_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::radix_sort_splice(range,
+                                enranged::before_begin(range),
+                                ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, msd_radix_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::msd_radix_sort_splice(range,
+                                    enranged::before_begin(range),
+                                    ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, buffered_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::buffered_sort_splice(std::allocator<int>{}, range,
+                                   enranged::before_begin(range),
+                                   ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks,
+                            prefetching_buffered_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::buffered_sort_splice(enranged::prefetching_sort_policy<>{},
+                                   std::allocator<int>{}, range,
+                                   enranged::before_begin(range),
+                                   ranges::end(range));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, partial_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::partial_sort_splice(range, enranged::before_begin(range),
+                                  state.range(0), state.range(1));
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, nth_element_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::nth_element_splice(range, enranged::before_begin(range),
+                                 state.range(0), state.range(0) / 2);
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, quick_sort_forward_list,
+                            std::forward_list<int, shuffled_allocator<int>>)
+  (benchmark::State& state) {
+  for (auto _ : state) {
+    auto& range = this->rebuild_list(state);
+    enranged::quick_sort_splice(range, enranged::before_begin(range),
+                                state.range(0));
+  }
+}
+
 BENCHMARK_TEMPLATE_DEFINE_F(SortingBenchmarks, std_sort_forward_list,
                             std::forward_list<int, shuffled_allocator<int>>)
   (benchmark::State& state) {
@@ -180,6 +664,113 @@ BENCHMARK_REGISTER_F(SortingBenchmarks, bucket_sort_list)
   ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
   ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_REGISTER_F(SortingBenchmarks, bucket_sort_three_way_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, bucket_sort_bucket_of_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, bucket_sort_many_buckets_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, bucket_sort_runtime_buckets_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, merging_bucket_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, merge_sort_expensive_key_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, key_caching_merge_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, network_merge_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, network_16_merge_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, prefetching_merge_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, prefetching_bucket_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, radix_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, msd_radix_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, buffered_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, prefetching_buffered_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, partial_sort_list)
+  ->ArgsProduct({benchmark::CreateRange(MinSize, MaxSize, Multiplier),
+                 {10, 1000}})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, nth_element_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, quick_sort_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, quick_sort_few_keys_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, merge_sort_few_keys_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, galloping_merge_sort_few_keys_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, counting_sort_few_keys_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, group_by_few_keys_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, merge_splice_list)
+  ->ArgsProduct({benchmark::CreateRange(MinSize, MaxSize, Multiplier),
+                 {8, 64}})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, merge_splice_two_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, std_merge_list)
+  ->ArgsProduct({benchmark::CreateRange(MinSize, MaxSize, Multiplier),
+                 {2, 8, 64}})
+  ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_REGISTER_F(SortingBenchmarks, std_sort_list)
   ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
   ->Unit(benchmark::kMicrosecond);
@@ -188,10 +779,57 @@ BENCHMARK_REGISTER_F(SortingBenchmarks, merge_sort_forward_list)
   ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
   ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_REGISTER_F(SortingBenchmarks, bottom_up_merge_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_REGISTER_F(SortingBenchmarks, bucket_sort_forward_list)
   ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
   ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_REGISTER_F(SortingBenchmarks, prefetching_merge_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, parallel_merge_sort_forward_list)
+  ->ArgsProduct({benchmark::CreateRange(MinSize, MaxSize, Multiplier),
+                 {1, 2, 4, 8}})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, parallel_bucket_sort_forward_list)
+  ->ArgsProduct({benchmark::CreateRange(MinSize, MaxSize, Multiplier),
+                 {1, 2, 4, 8}})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, radix_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, msd_radix_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, buffered_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, prefetching_buffered_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, partial_sort_forward_list)
+  ->ArgsProduct({benchmark::CreateRange(MinSize, MaxSize, Multiplier),
+                 {10, 1000}})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, nth_element_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(SortingBenchmarks, quick_sort_forward_list)
+  ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
+  ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_REGISTER_F(SortingBenchmarks, std_sort_forward_list)
   ->RangeMultiplier(Multiplier)->Range(MinSize, MaxSize)
   ->Unit(benchmark::kMicrosecond);
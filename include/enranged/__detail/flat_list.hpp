@@ -5,6 +5,7 @@
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 /**
  * @file
@@ -31,19 +32,63 @@ using min_unsigned_t_for =
                                                            uint64_t>>>;
 
 /**
- * @brief A simple pseudo-list of limited size implemented over a
- *        contiguous array
+ * @brief  The common part of merge_adjacent() of the ranked lists
+ *         below: walks the size elements slot(order[0]), ...,
+ *         slot(order[size - 1]) calling merge(lhs, rhs) for the
+ *         neighbouring ones, removing lhs every time it returns true,
+ *         and moves the kept elements into the slots below the new
+ *         size, so that the ones past it can simply be dropped
+ * @return The number of the kept elements
+ **/
+template <typename Order, typename Slot, typename Merge>
+size_t merge_adjacent_ranked(Order& order, const size_t size,
+                             const Slot slot, Merge& merge) {
+  // Compact the kept elements into the lowest ranks first
+  size_t kept = 0;
+  for (size_t rank = 1; rank < size; ++rank) {
+    auto& lhs = slot(order[kept]);
+    auto& rhs = slot(order[rank]);
+    if (merge(lhs, rhs)) lhs = std::move(rhs);
+    else if (++kept != rank) slot(order[kept]) = std::move(rhs);
+  }
+  ++kept;
+
+  // Then move the ones stored in the slots past the new size into
+  // the free ones below it, listed in order[kept, free_end)
+  size_t free_end = kept;
+  for (size_t rank = kept; rank < size; ++rank)
+    if (order[rank] < kept) order[free_end++] = order[rank];
+
+  for (size_t rank = 0; rank < kept; ++rank) {
+    if (order[rank] < kept) continue;
+    const auto free_pos = order[--free_end];
+    slot(free_pos) = std::move(slot(order[rank]));
+    order[rank] = free_pos;
+  }
+
+  return kept;
+}
+
+/**
+ * @brief A pseudo-list of limited size that provides access to its
+ *        elements by rank (i.e., their position in the list), so that
+ *        it can be binary searched.
+ *        The elements are never moved, an insertion only shifts
+ *        their (small) indices in a contiguous array
  **/
 template <typename T, size_t _max_size>
-class flat_list {
+class flat_ranked_list {
 public:
   using pos_t = min_unsigned_t_for<_max_size>;
 
-  flat_list() noexcept {
-    links_[0] = _max_size;  // Marks the end
-  }
+  /**
+   * @brief Creates an empty list that will hold at most capacity
+   *        (which must not exceed _max_size) elements
+   **/
+  explicit flat_ranked_list(const size_t capacity = _max_size) noexcept:
+    capacity_(capacity) {}
 
-  ~flat_list() noexcept {
+  ~flat_ranked_list() noexcept {
     clear();
   }
 
@@ -54,12 +99,11 @@ public:
 
     iterator() noexcept = default;
     bool operator==(const iterator& other) const noexcept {
-      return pos_ == other.pos_;  // Comparison between different
-                                  // containers is UB anyway
+      return rank_ == other.rank_;
     }
 
     T* operator->() const noexcept {
-      return (reinterpret_cast<T*>(list_->data_) + pos_);
+      return reinterpret_cast<T*>(list_->data_) + list_->order_[rank_];
     }
 
     T& operator*() const noexcept {
@@ -67,7 +111,7 @@ public:
     }
 
     iterator& operator++() noexcept {
-      pos_ = list_->links_[pos_ + 1];
+      ++rank_;
       return *this;
     }
 
@@ -77,20 +121,26 @@ public:
       return result;
     }
 
+    size_t rank() const noexcept {
+      return rank_;
+    }
+
   private:
-    iterator(flat_list* const list, const size_t pos) noexcept:
-      list_(list), pos_(pos) {}
+    iterator(flat_ranked_list* const list, const size_t rank) noexcept:
+      list_(list), rank_(rank) {}
 
-    flat_list* list_;
-    size_t pos_;
+    flat_ranked_list* list_;
+    size_t rank_;
 
-    friend class flat_list;
+    friend class flat_ranked_list;
   };
 
   /**
    * @brief  Constructs an element after the given iterator using the
-   *         provided arguments. No iterators are invalidated. If the
-   *         list already has _max_size elements or (it) is not
+   *         provided arguments. The iterators to the elements
+   *         following the new one are invalidated (or rather, now
+   *         point to the elements preceding the ones they used to).
+   *         If the list already has _max_size elements or (it) is not
    *         before_begin() or dereferenceable, the behaviour is
    *         undefined
    * @return An iterator to the newly constructed element
@@ -101,11 +151,19 @@ public:
     new (static_cast<void*>(data_ + sizeof(T) * size_))
       T{std::forward<Args>(args)...};
 
-    auto& it_link = links_[it.pos_ + 1];
-    links_[size_ + 1] = it_link;
-    it_link = pos_t(size_);
+    const size_t rank = it.rank_ + 1;  // Wraps for before_begin()
+    for (size_t i = size_; i > rank; --i) order_[i] = order_[i - 1];
+    order_[rank] = pos_t(size_++);
+
+    return { this, rank };
+  }
 
-    return { this, size_++ };
+  /**
+   * @brief Returns an iterator to the element of the given rank (or
+   *        end() if rank == size())
+   **/
+  iterator nth(const size_t rank) noexcept {
+    return { this, rank };
   }
 
   iterator before_begin() noexcept {
@@ -113,17 +171,40 @@ public:
   }
 
   iterator begin() noexcept {
-    return { this, *links_ };
+    return { this, 0 };
   }
 
   iterator end() noexcept {
-    return { this, _max_size };
+    return { this, size_ };
   }
 
   size_t size() const noexcept {
     return size_;
   }
 
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /**
+   * @brief Walks the list calling merge(lhs, rhs) for the neighbouring
+   *        elements, and removes lhs every time it returns true (i.e.,
+   *        lhs has been merged into rhs, which is then passed on as
+   *        the next lhs). Takes linear time, all the iterators are
+   *        invalidated
+   **/
+  template <typename Merge>
+  void merge_adjacent(Merge merge) {
+    if (size_ < 2) return;
+
+    const size_t kept = merge_adjacent_ranked
+      (order_, size_, [this](const size_t pos) -> T& { return slot(pos); },
+       merge);
+
+    for (size_t pos = kept; pos < size_; ++pos) slot(pos).~T();
+    size_ = kept;
+  }
+
   void clear() noexcept {
     auto it = reinterpret_cast<T*>(data_);
     const auto end = it + size_;
@@ -133,12 +214,273 @@ public:
   }
 
 private:
+  T& slot(const size_t pos) noexcept {
+    return reinterpret_cast<T*>(data_)[pos];
+  }
+
   size_t size_ = 0;
-  pos_t links_[_max_size + 1]; // links_[i] = the index of the next after
-                               // (i-1)-th element (first if i == 0)
+  size_t capacity_;
+  pos_t order_[_max_size]; // order_[i] = the index of the i-th element
 
   alignas(T) byte data_[sizeof(T) * _max_size];
   friend class iterator;
 };
 
+/**
+ * @brief The same as flat_ranked_list, but with the capacity given at
+ *        runtime: the elements and their indices are stored in
+ *        vectors reserved with the provided allocator upfront, so the
+ *        elements are still never moved
+ **/
+template <typename T, typename Allocator>
+class ranked_list {
+  using traits = std::allocator_traits<Allocator>;
+
+public:
+  ranked_list(const size_t capacity, Allocator alloc):
+    data_(typename traits::template rebind_alloc<T>(alloc)),
+    order_(capacity, typename traits::template rebind_alloc<size_t>(alloc)) {
+    data_.reserve(capacity);
+  }
+
+  class iterator {
+  public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+    bool operator==(const iterator& other) const noexcept {
+      return rank_ == other.rank_;
+    }
+
+    T* operator->() const noexcept {
+      return list_->data_.data() + list_->order_[rank_];
+    }
+
+    T& operator*() const noexcept {
+      return *this->operator->();
+    }
+
+    iterator& operator++() noexcept {
+      ++rank_;
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator result{*this};
+      ++*this;
+      return result;
+    }
+
+    size_t rank() const noexcept {
+      return rank_;
+    }
+
+  private:
+    iterator(ranked_list* const list, const size_t rank) noexcept:
+      list_(list), rank_(rank) {}
+
+    ranked_list* list_;
+    size_t rank_;
+
+    friend class ranked_list;
+  };
+
+  /**
+   * @brief  Constructs an element after the given iterator using the
+   *         provided arguments (see flat_ranked_list::emplace_after()).
+   *         If the list is already full, the behaviour is undefined
+   * @return An iterator to the newly constructed element
+   **/
+  template <typename... Args>
+  iterator emplace_after(const iterator& it, Args&&... args)
+    noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+    const size_t size = data_.size();
+    data_.push_back(T{std::forward<Args>(args)...});  // Never reallocates
+
+    const size_t rank = it.rank_ + 1;  // Wraps for before_begin()
+    for (size_t i = size; i > rank; --i) order_[i] = order_[i - 1];
+    order_[rank] = size;
+
+    return { this, rank };
+  }
+
+  iterator nth(const size_t rank) noexcept {
+    return { this, rank };
+  }
+
+  iterator before_begin() noexcept {
+    return { this, size_t(-1) };
+  }
+
+  iterator begin() noexcept {
+    return { this, 0 };
+  }
+
+  iterator end() noexcept {
+    return { this, data_.size() };
+  }
+
+  size_t size() const noexcept {
+    return data_.size();
+  }
+
+  size_t capacity() const noexcept {
+    return order_.size();
+  }
+
+  /**
+   * @brief Removes the elements merged into their right neighbours
+   *        (see flat_ranked_list::merge_adjacent())
+   **/
+  template <typename Merge>
+  void merge_adjacent(Merge merge) {
+    const size_t size = data_.size();
+    if (size < 2) return;
+
+    const size_t kept = merge_adjacent_ranked
+      (order_, size, [this](const size_t pos) -> T& { return data_[pos]; },
+       merge);
+
+    data_.erase(data_.begin() + kept, data_.end());
+  }
+
+  void clear() noexcept {
+    data_.clear();
+  }
+
+private:
+  std::vector<T, typename traits::template rebind_alloc<T>> data_;
+  std::vector<size_t, typename traits::template rebind_alloc<size_t>> order_;
+
+  friend class iterator;
+};
+
+/**
+ * @brief A singly linked list stored in vectors (allocated with the
+ *        provided allocator), with the nodes linked by their
+ *        indices. It is a spliceable range, so the sorting algorithms
+ *        can run on it directly, e.g., to sort the proxies of the
+ *        elements of another range
+ **/
+template <typename T, typename Allocator>
+class linked_vector {
+  using traits = std::allocator_traits<Allocator>;
+  constexpr static size_t end_pos = size_t(-2);
+
+public:
+  explicit linked_vector(Allocator alloc):
+    data_(typename traits::template rebind_alloc<T>(alloc)),
+    links_(1, end_pos,
+           typename traits::template rebind_alloc<size_t>(alloc)) {}
+
+  class iterator {
+  public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+    bool operator==(const iterator& other) const noexcept {
+      return pos_ == other.pos_;
+    }
+
+    T* operator->() const noexcept {
+      return list_->data_.data() + pos_;
+    }
+
+    T& operator*() const noexcept {
+      return *this->operator->();
+    }
+
+    iterator& operator++() noexcept {
+      pos_ = list_->links_[pos_ + 1];
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator result{*this};
+      ++*this;
+      return result;
+    }
+
+  private:
+    iterator(linked_vector* const list, const size_t pos) noexcept:
+      list_(list), pos_(pos) {}
+
+    linked_vector* list_;
+    size_t pos_;
+
+    friend class linked_vector;
+  };
+
+  /**
+   * @brief  Constructs an element after the given iterator using the
+   *         provided arguments. No iterators are invalidated (but the
+   *         references to the elements may be)
+   * @return An iterator to the newly constructed element
+   **/
+  template <typename... Args>
+  iterator emplace_after(const iterator& it, Args&&... args) {
+    const size_t pos = data_.size();
+    data_.push_back(T{std::forward<Args>(args)...});
+
+    links_.push_back(links_[it.pos_ + 1]);
+    links_[it.pos_ + 1] = pos;
+
+    return { this, pos };
+  }
+
+  /**
+   * @brief Reserves the memory for (at least) count elements, so that
+   *        adding them does not reallocate
+   **/
+  void reserve(const size_t count) {
+    data_.reserve(count);
+    links_.reserve(count + 1);
+  }
+
+  iterator before_begin() noexcept {
+    return { this, size_t(-1) };
+  }
+
+  iterator begin() noexcept {
+    return { this, links_[0] };
+  }
+
+  iterator end() noexcept {
+    return { this, end_pos };
+  }
+
+  size_t size() const noexcept {
+    return data_.size();
+  }
+
+  /**
+   * @brief Moves the elements in (lt, rt] after pos (see cosplice())
+   **/
+  void cosplice(const iterator pos, linked_vector&,
+                const iterator lt, const iterator rt) noexcept {
+    const size_t first = links_[lt.pos_ + 1];
+    links_[lt.pos_ + 1] = links_[rt.pos_ + 1];
+    links_[rt.pos_ + 1] = links_[pos.pos_ + 1];
+    links_[pos.pos_ + 1] = first;
+  }
+
+  /**
+   * @brief Moves the element following (it) after pos
+   **/
+  void cosplice(const iterator pos, linked_vector& src,
+                const iterator it) noexcept {
+    cosplice(pos, src, it, std::next(it));
+  }
+
+private:
+  std::vector<T, typename traits::template rebind_alloc<T>> data_;
+  // links_[i] = the index of the next after (i-1)-th element (first
+  // if i == 0)
+  std::vector<size_t, typename traits::template rebind_alloc<size_t>> links_;
+
+  friend class iterator;
+};
+
 } // namespace enranged::__detail
@@ -0,0 +1,251 @@
+#pragma once
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sorting_impl.hpp"
+
+/**
+ * @file
+ * Implementation of parallel sorting algorithms for certain kinds of
+ * ranges
+ *
+ * @author    patternnoster@github
+ * @copyright 2023, under the MIT License (see /LICENSE for details)
+ **/
+
+namespace enranged::__detail {
+
+/**
+ * @brief The executor used for the standard parallel execution
+ *        policies: runs every task in its own thread and joins all of
+ *        them on destruction
+ **/
+class thread_executor {
+public:
+  void execute(std::function<void()> task) {
+    threads_.emplace_back(std::move(task));
+  }
+
+  size_t max_concurrency() const noexcept {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+private:
+  std::vector<std::jthread> threads_;
+};
+
+/**
+ * @brief Calls task(i) for every i in [0, count) with the executor
+ *        (task(0) is called on the current thread), waits for all of
+ *        them to finish and rethrows the first exception thrown by
+ *        any of them, if there was one
+ **/
+template <typename Executor, typename Task>
+void run_tasks(Executor& executor, const size_t count, const Task& task) {
+  std::vector<std::exception_ptr> errors(count);
+  std::latch done(count - 1);
+
+  size_t submitted = 1;
+  try {
+    for (; submitted < count; ++submitted)
+      executor.execute([&task, &errors, &done, idx = submitted]() {
+        try { task(idx); }
+        catch (...) { errors[idx] = std::current_exception(); }
+        done.count_down();
+      });
+  }
+  catch (...) {
+    // We still have to wait for the tasks that have been submitted,
+    // since they reference our stack
+    done.count_down(count - submitted);
+    done.wait();
+    throw;
+  }
+
+  try { task(0); }
+  catch (...) { errors[0] = std::current_exception(); }
+  done.wait();
+
+  for (const auto& error : errors)
+    if (error) std::rethrow_exception(error);
+}
+
+template <typename Policy, typename Executor>
+size_t parallel_parts(Executor& executor, const size_t size) {
+  return std::min<size_t>(executor.max_concurrency(),
+                          size / std::max<size_t>(Policy::parallel_min_chunk,
+                                                  2));
+}
+
+template <typename Executor, typename R, left_limit_of<R> L,
+          typename Comp, typename Policy>
+ranges::borrowed_iterator_t<R> parallel_merge_sort_splice
+  (Executor& executor, R&& range, const L left, const size_t size,
+   const Comp comp, const Policy& policy) {
+  static_assert(!Policy::collect_stats,
+                "The parallel algorithms don't collect sort statistics");
+  static_assert(!Policy::cache_keys,
+                "The parallel algorithms don't cache the sort keys");
+  using iterator = ranges::iterator_t<R>;
+
+  const size_t parts = __detail::parallel_parts<Policy>(executor, size);
+  if (parts < 2)
+    return __detail::merge_sort_splice(range, left, size, comp, policy);
+
+  /* Several threads cannot splice next to the same node, so we cut
+   * the corange into parts separated by single nodes that are not
+   * moved until the parts are sorted:
+   * (left, ...] s_1 (s_1, ...] s_2 ... s_{parts - 1} (s_{parts - 1}, ...]
+   * Separators are then merged into the neighbouring parts pairwise,
+   * forming the same structure twice as sparse */
+  std::vector<iterator> seps(parts);  // seps[0] is never used
+  std::vector<iterator> lasts(parts);
+  std::vector<size_t> sizes(parts);
+
+  const size_t to_sort = size - (parts - 1);
+  for (size_t i = 0; i < parts; ++i)
+    sizes[i] = to_sort / parts + (i < to_sort % parts);
+
+  auto it = ranges::next(after(range, left), sizes[0] - 1);
+  for (size_t i = 1; i < parts; ++i) {
+    seps[i] = ranges::next(it);
+    it = ranges::next(seps[i], sizes[i]);
+  }
+
+  __detail::run_tasks(executor, parts, [&](const size_t idx) {
+    if (idx == 0)
+      lasts[0] = __detail::merge_sort_splice(range, left, sizes[0],
+                                             comp, policy);
+    else
+      lasts[idx] = __detail::merge_sort_splice(range, seps[idx], sizes[idx],
+                                               comp, policy);
+  });
+
+  for (size_t step = 1; step < parts; step*= 2) {
+    const size_t groups = (parts - step + 2*step - 1) / (2*step);
+    __detail::run_tasks(executor, groups, [&](const size_t idx) {
+      const size_t lhs = 2*step*idx, rhs = lhs + step;
+
+      // The separator goes to the right-hand side part first
+      const auto rhs_last =
+        __detail::coinplace_merge_splice(range, lasts[lhs], seps[rhs],
+                                         lasts[rhs], comp, policy);
+      if (lhs == 0)
+        lasts[0] = __detail::coinplace_merge_splice(range, left, lasts[0],
+                                                    rhs_last, comp, policy);
+      else
+        lasts[lhs] =
+          __detail::coinplace_merge_splice(range, seps[lhs], lasts[lhs],
+                                           rhs_last, comp, policy);
+    });
+  }
+
+  return lasts[0];
+}
+
+template <typename Executor,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Comp, typename Buckets, typename Policy>
+std::pair<size_t, ranges::borrowed_iterator_t<R>> parallel_bucket_sort_splice
+  (Executor& executor, R&& range, const L1 left, const L2 end,
+   const EqRel is_eq, const Comp comp, Buckets& memory, const Policy& policy) {
+  static_assert(!Policy::collect_stats,
+                "The parallel algorithms don't collect sort statistics");
+  static_assert(!Policy::cache_keys,
+                "The parallel algorithms don't cache the sort keys");
+  using iterator = ranges::iterator_t<R>;
+
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  const bool last_buck_dirty =
+    __detail::bucket_sort_distribute(range, left, end, is_eq, comp,
+                                     memory, policy);
+
+  size_t size = 0;
+  for (const auto& bucket : memory) size+= bucket.size;
+
+  const size_t buckets = memory.size();
+  const size_t parts =
+    std::min(buckets, __detail::parallel_parts<Policy>(executor, size));
+  if (parts < 2)
+    return __detail::bucket_sort_buckets(range, left, last_buck_dirty, comp,
+                                         memory, policy);
+
+  // The sorting of the buckets is the part we can parallelize, so
+  // gather them up in the arrays first
+  std::vector<size_t> sizes;
+  std::vector<iterator> lasts;
+  sizes.reserve(buckets);
+  lasts.reserve(buckets);
+
+  for (const auto& [buck_size, buck_last] : memory) {
+    sizes.push_back(buck_size);
+    lasts.push_back(buck_last);
+  }
+
+  /* Split the buckets into groups of roughly the same size, each
+   * sorted by its own thread. The first elements of the groups serve
+   * as separators: they are excluded from sorting and put into place
+   * after all the threads are done (see parallel_merge_sort_splice
+   * for the reasoning) */
+  std::vector<size_t> group_begins{0};
+  for (size_t b = 1, acc = sizes[0]; b < buckets; ++b) {
+    if (acc >= size * group_begins.size() / parts)
+      group_begins.push_back(b);
+    acc+= sizes[b];
+  }
+  const size_t groups = group_begins.size();
+  group_begins.push_back(buckets);
+
+  std::vector<iterator> seps(groups);  // seps[0] is never used
+  std::vector<iterator> prefix_lasts(groups);
+  for (size_t g = 1; g < groups; ++g)
+    seps[g] = ranges::next(lasts[group_begins[g] - 1]);
+
+  __detail::run_tasks(executor, groups, [&](const size_t idx) {
+    size_t b = group_begins[idx];
+    if (idx == 0)
+      lasts[0] = __detail::merge_sort_splice(range, left, sizes[0],
+                                             comp, policy);
+    else {
+      const auto sep = seps[idx];
+      lasts[b] = sizes[b] == 1 ? sep
+        : __detail::merge_sort_splice(range, sep, sizes[b] - 1, comp, policy);
+
+      // The elements (strictly) less than the separator will go
+      // before it. That keeps the sorting stable, since the separator
+      // was the first in its bucket
+      auto prefix_last = sep;
+      for (; prefix_last != lasts[b]; ++prefix_last)
+        if (!comp(*ranges::next(prefix_last), *sep)) break;
+      prefix_lasts[idx] = prefix_last;
+    }
+
+    for (++b; b < group_begins[idx + 1]; ++b)
+      lasts[b] = __detail::merge_sort_splice(range, lasts[b - 1], sizes[b],
+                                             comp, policy);
+  });
+
+  for (size_t g = 1; g < groups; ++g) {
+    const size_t b = group_begins[g];
+    if (prefix_lasts[g] == seps[g]) continue;
+
+    cosplice(range, lasts[b - 1], range, seps[g], prefix_lasts[g]);
+    if (prefix_lasts[g] == lasts[b]) lasts[b] = seps[g];
+  }
+
+  auto last = lasts.back();
+  if (last_buck_dirty && buckets > 1)
+    last = __detail::coinplace_merge_splice(range, left, lasts[buckets - 2],
+                                            last, comp, policy);
+
+  return std::make_pair(size, last);
+}
+
+} // namespace enranged::__detail
@@ -1,11 +1,22 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
 #include <concepts>
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 #include "../splicing.hpp"
 
@@ -37,10 +48,251 @@ constexpr decltype(auto) project_predicate(Pred& pred, Proj& proj) noexcept {
     };
 }
 
-template <spliceable_range R, left_limit_of<R> L, typename Comp>
+/**
+ * @brief Same as the above, but also counts the calls in the sort
+ *        statistics if the policy collects them (see
+ *        stats_sort_policy)
+ **/
+template <typename Pred, typename Proj, typename Policy>
+constexpr decltype(auto) project_predicate(Pred& pred, Proj& proj,
+                                           const Policy& policy) noexcept {
+  if constexpr (!Policy::collect_stats)
+    return __detail::project_predicate(pred, proj);
+  else
+    return [projected = __detail::project_predicate(pred, proj),
+            stats = policy.stats](auto&& lhs, auto&& rhs) {
+      ++stats->comparisons;
+      return projected(std::forward<decltype(lhs)>(lhs),
+                       std::forward<decltype(rhs)>(rhs));
+    };
+}
+
+/**
+ * @brief Calls update(stats) with the sort statistics if the policy
+ *        collects them (see stats_sort_policy), does nothing (and
+ *        compiles to nothing) otherwise
+ **/
+template <typename Policy, typename F>
+constexpr void update_stats([[maybe_unused]] const Policy& policy,
+                            [[maybe_unused]] const F update) noexcept {
+  if constexpr (Policy::collect_stats) update(*policy.stats);
+}
+
+/**
+ * @brief Increases the recursion depth in the sort statistics (if the
+ *        policy collects them) for its lifetime, so that the depth is
+ *        restored when the comparator throws as well
+ **/
+template <typename Policy>
+class stats_depth_guard {
+public:
+  constexpr explicit stats_depth_guard(const Policy& policy) noexcept:
+    policy_(policy) {
+    __detail::update_stats(policy, [](auto& stats) {
+      stats.max_depth = std::max(stats.max_depth, ++stats.depth);
+    });
+  }
+
+  stats_depth_guard(const stats_depth_guard&) = delete;
+  stats_depth_guard& operator=(const stats_depth_guard&) = delete;
+
+  constexpr ~stats_depth_guard() {
+    __detail::update_stats(policy_, [](auto& stats) { --stats.depth; });
+  }
+
+private:
+  const Policy& policy_;
+};
+
+/**
+ * @brief The strict weak order given by a three-way comparator (i.e.,
+ *        returning values convertible to std::weak_ordering)
+ **/
+template <typename Cmp>
+struct three_way_less {
+  template <typename T, typename U>
+    requires requires(const Cmp& cmp, T&& lhs, U&& rhs) {
+      { std::invoke(cmp, std::forward<T>(lhs), std::forward<U>(rhs)) }
+        -> std::convertible_to<std::weak_ordering>;
+    }
+  constexpr bool operator()(T&& lhs, U&& rhs) const {
+    return std::invoke(cmp, std::forward<T>(lhs), std::forward<U>(rhs)) < 0;
+  }
+
+  Cmp cmp;
+};
+
+/**
+ * @brief The equivalence relation given by a three-way comparator
+ **/
+template <typename Cmp>
+struct three_way_equal {
+  template <typename T, typename U>
+  constexpr bool operator()(T&& lhs, U&& rhs) const {
+    return std::invoke(cmp, std::forward<T>(lhs), std::forward<U>(rhs)) == 0;
+  }
+
+  Cmp cmp;
+};
+
+/**
+ * @brief Compares lhs with rhs using the strict weak order comp,
+ *        i.e., calls comp(lhs, rhs) and then, if it is false,
+ *        comp(rhs, lhs)
+ **/
+template <typename Comp, typename T, typename U>
+constexpr std::weak_ordering weak_order(const Comp& comp,
+                                        T&& lhs, U&& rhs) {
+  if (comp(lhs, rhs)) return std::weak_ordering::less;
+  if (comp(rhs, lhs)) return std::weak_ordering::greater;
+  return std::weak_ordering::equivalent;
+}
+
+/**
+ * @brief Same as the above, but makes a single call of the three-way
+ *        comparator the order is given by
+ **/
+template <typename Cmp, typename T, typename U>
+constexpr std::weak_ordering weak_order(const three_way_less<Cmp>& comp,
+                                        T&& lhs, U&& rhs) {
+  return std::invoke(comp.cmp, lhs, rhs);
+}
+
+/**
+ * @brief Compares lhs with rhs for the bucket sort: lhs is equivalent
+ *        to rhs iff is_eq(lhs, rhs), and greater than it iff, in
+ *        addition, comp(rhs, lhs) (which is only called when needed)
+ **/
+template <typename EqRel, typename Comp, typename T, typename U>
+constexpr std::weak_ordering bucket_order(const EqRel& is_eq,
+                                          const Comp& comp,
+                                          T&& lhs, U&& rhs) {
+  if (is_eq(lhs, rhs)) return std::weak_ordering::equivalent;
+  return comp(rhs, lhs) ? std::weak_ordering::greater
+                        : std::weak_ordering::less;
+}
+
+/**
+ * @brief Same as the above, but makes a single call of the three-way
+ *        comparator both the relation and the order are given by
+ **/
+template <typename Cmp, typename T, typename U>
+constexpr std::weak_ordering bucket_order(const three_way_equal<Cmp>& is_eq,
+                                          const three_way_less<Cmp>&,
+                                          T&& lhs, U&& rhs) {
+  return std::invoke(is_eq.cmp, lhs, rhs);
+}
+
+/**
+ * @brief Same as project_predicate(), but turns a three-way comparator
+ *        on the projections into the strict weak order it gives (see
+ *        three_way_less)
+ **/
+template <typename I, typename Comp, typename Proj>
+constexpr auto project_order(Comp& comp, Proj& proj) noexcept {
+  if constexpr (std::indirect_strict_weak_order<std::remove_cv_t<Comp>,
+                                                std::projected<I, Proj>>)
+    return __detail::project_predicate(comp, proj);
+  else
+    return three_way_less{__detail::project_predicate(comp, proj)};
+}
+
+template <typename R>
+concept has_prefetch = requires(R obj, ranges::iterator_t<R> it) {
+  { obj.prefetch(it) } noexcept;
+};
+
+inline void prefetch_address([[maybe_unused]] const void* const ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#endif
+}
+
+/**
+ * @brief Hints that the element pointed to by the given
+ *        (dereferenceable) iterator will be accessed soon, if the
+ *        policy enables prefetching. Uses the range's own prefetch()
+ *        method if it is defined and the address of the element
+ *        otherwise
+ **/
+template <typename Policy, typename R>
+constexpr void prefetch(R& range, const ranges::iterator_t<R> it) noexcept {
+  if constexpr (Policy::prefetch) {
+    if (std::is_constant_evaluated()) return;
+
+    if constexpr (has_prefetch<R&>)
+      range.prefetch(it);
+    else if constexpr
+      (std::is_lvalue_reference_v<std::iter_reference_t<ranges::iterator_t<R>>>)
+      prefetch_address(std::addressof(*it));
+  }
+}
+
+/**
+ * @brief Given a dereferenceable iterator it, such that pred(*it)
+ *        holds, and a right limit bound, such that pred holds on a
+ *        prefix of [it, bound) and doesn't on the rest of it, returns
+ *        an iterator to the last element of that prefix
+ *
+ * The first _min_gallop elements are scanned linearly, then the
+ * search switches to exponential probing from the last element known
+ * to satisfy pred (a checkpoint) followed by bisection, so a prefix of
+ * n elements takes O(log n) comparisons. Probes are reached by walking
+ * from the checkpoint, which still takes O(n) steps
+ **/
+template <typename I, typename S, typename Pred, typename Policy>
+constexpr I gallop_last(I it, const S bound, const Pred pred,
+                        const Policy& policy) {
+  for (size_t steps = 0; steps < Policy::min_gallop; ++steps) {
+    const auto next = ranges::next(it);
+    if (next == bound || !pred(*next)) return it;
+    it = next;
+    __detail::update_stats(policy, [](auto& stats) { ++stats.traversed; });
+  }
+
+  for (size_t step = 1;; step*= 2) {
+    auto probe = it;
+    size_t dist = 0;
+    for (; dist < step; ++dist) {
+      const auto next = ranges::next(probe);
+      if (next == bound) break;
+      probe = next;
+    }
+    __detail::update_stats(policy, [dist](auto& stats) {
+      stats.traversed+= dist;
+    });
+
+    if (dist == 0) return it;
+    if (!pred(*probe)) {
+      // The answer is in [it, probe), dist elements away from it
+      while (dist > 1) {
+        const size_t half = dist / 2;
+        const auto mid = ranges::next(it, half);
+        __detail::update_stats(policy, [half](auto& stats) {
+          stats.traversed+= half;
+        });
+        if (pred(*mid)) {
+          it = mid;
+          dist-= half;
+        }
+        else dist = half;
+      }
+      return it;
+    }
+
+    it = probe;
+    if (dist < step) return it;  // Reached the bound
+  }
+}
+
+template <spliceable_range R, left_limit_of<R> L,
+          typename Comp, typename Policy>
 constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
   (R&& range, const L left, const ranges::iterator_t<R> middle,
-   const ranges::iterator_t<R> last, const Comp comp) {
+   const ranges::iterator_t<R> last, const Comp comp,
+   [[maybe_unused]] const Policy& policy) {
   // We assume left != last, since middle must be in the corange
   if (middle == last) [[unlikely]] return last;
 
@@ -63,9 +315,17 @@ constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
     // We need to put some part of the right side front, figure out
     // how big of a part that is
     ranges::iterator_t<R> rhs_next = ranges::next(rhs);
-    for (; rhs_next != end && comp(*rhs_next, *lhs); rhs = rhs_next++);
+    if constexpr (Policy::min_gallop > 0) {
+      rhs = __detail::gallop_last
+        (rhs, end, [&](auto&& x) { return comp(x, *lhs); }, policy);
+      rhs_next = ranges::next(rhs);
+    }
+    else
+      for (; rhs_next != end && comp(*rhs_next, *lhs); rhs = rhs_next++)
+        __detail::update_stats(policy, [](auto& stats) { ++stats.traversed; });
 
     cosplice(range, left, middle, rhs);
+    __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
 
     if (rhs_next == end) return middle;
     if (lhs == middle || !comp(*rhs_next, *middle)) return last;
@@ -77,17 +337,43 @@ constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
   // Invariant #4: *lhs <= *rhs
 
   for (;;) {
+    ranges::iterator_t<R> rhs_next = ranges::next(rhs);
+
+    // The scans below are pointer chasing, so the best we can do is
+    // to fetch the next node on one side while scanning the other one
+    if constexpr (Policy::prefetch)
+      if (rhs_next != end) __detail::prefetch<Policy>(range, rhs_next);
+
     // Find the first left-hand side element that is greater than
     // *rhs. Because of invariant #2, such element always exists
     ranges::iterator_t<R> lhs_next = ranges::next(lhs);
-    for (; !comp(*rhs, *lhs_next); lhs = lhs_next++);
+    if constexpr (Policy::min_gallop > 0) {
+      lhs = __detail::gallop_last
+        (lhs, middle, [&](auto&& x) { return !comp(*rhs, x); }, policy);
+      lhs_next = ranges::next(lhs);
+    }
+    else
+      for (; !comp(*rhs, *lhs_next); lhs = lhs_next++)
+        __detail::update_stats(policy, [](auto& stats) { ++stats.traversed; });
+
+    if constexpr (Policy::prefetch)
+      if (lhs_next != middle)
+        __detail::prefetch<Policy>(range, ranges::next(lhs_next));
 
     // Now *lhs <= *rhs < *lhs_next. Find out, how big of a part
     // following rhs we can splice in-between them
-    ranges::iterator_t<R> rhs_next = ranges::next(rhs);
-    for (; rhs_next != end && comp(*rhs_next, *lhs_next); rhs = rhs_next++);
+    if constexpr (Policy::min_gallop > 0) {
+      rhs = __detail::gallop_last
+        (rhs, end, [&](auto&& x) { return comp(x, *lhs_next); }, policy);
+      rhs_next = ranges::next(rhs);
+    }
+    else
+      for (; rhs_next != end && comp(*rhs_next, *lhs_next);
+           rhs = rhs_next++)
+        __detail::update_stats(policy, [](auto& stats) { ++stats.traversed; });
 
     cosplice(range, lhs, middle, rhs);
+    __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
 
     if (rhs_next == end) return middle;
     if (lhs_next == middle || !comp(*rhs_next, *middle)) return last;
@@ -97,9 +383,462 @@ constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
   }
 }
 
-template <typename R, left_limit_of<R> L, typename Comp>
+template <typename D, typename S, typename Comp, typename Policy>
+constexpr void merge_splice(D&& dst, const std::vector<S*>& srcs,
+                            const Comp comp,
+                            [[maybe_unused]] const Policy& policy) {
+  using iterator = ranges::iterator_t<D>;
+
+  /* Source 0 is dst itself, its elements are never moved but the
+   * output position (after which the elements from the other sources
+   * are spliced) goes over them */
+  const size_t sources = srcs.size() + 1;
+  if (sources == 1) return;
+
+  std::vector<iterator> heads(sources);
+  heads[0] = ranges::begin(dst);
+  for (size_t i = 1; i < sources; ++i) heads[i] = ranges::begin(*srcs[i - 1]);
+
+  const auto done = [&](const size_t i) {
+    return i == 0 ? heads[0] == ranges::end(dst)
+      : heads[i] == ranges::end(*srcs[i - 1]);
+  };
+
+  // Whether the head of source i goes before the head of source j,
+  // the ties are broken by the source index to keep the merge stable
+  const auto beats = [&](const size_t i, const size_t j) {
+    if (done(j)) return true;
+    if (done(i)) return false;
+    return i < j ? !comp(*heads[j], *heads[i]) : comp(*heads[i], *heads[j]);
+  };
+
+  /* A loser tree: leaf i is the node i + sources of an implicit binary
+   * heap, every inner node keeps the loser of the match between the
+   * winners of its subtrees, and tree[0] is the overall winner. Thus,
+   * it only takes one match per level to replace the winner */
+  std::vector<size_t> tree(sources, sources);  // sources means none
+  size_t active = 0;
+  for (size_t i = 0; i < sources; ++i) {
+    if (!done(i)) ++active;
+
+    size_t cur = i;
+    for (size_t node = (i + sources) / 2; node > 0; node/= 2) {
+      if (tree[node] == sources) {
+        tree[node] = cur;
+        cur = sources;
+        break;
+      }
+      if (beats(tree[node], cur)) std::swap(tree[node], cur);
+    }
+    if (cur != sources) tree[0] = cur;
+  }
+
+  const auto replay = [&](size_t cur) {
+    for (size_t node = (cur + sources) / 2; node > 0; node/= 2)
+      if (beats(tree[node], cur)) std::swap(tree[node], cur);
+    tree[0] = cur;
+  };
+
+  /* The elements won by a source in a row are only spliced into dst
+   * (after out, once) when the winner changes: the pending run is
+   * (before_begin(*srcs[run - 1]), run_last] */
+  iterator out, run_last;
+  bool out_moved = false;
+  size_t run = 0;  // 0 means none, since dst elements stay in place
+
+  const auto flush = [&]() {
+    if (run == 0) return;
+
+    auto& src = *srcs[run - 1];
+    if (out_moved) cosplice(dst, out, src, before_begin(src), run_last);
+    else cosplice(dst, before_begin(dst), src, before_begin(src), run_last);
+
+    out = run_last;
+    out_moved = true;
+    run = 0;
+  };
+
+  while (active > 1) {
+    const size_t winner = tree[0];
+    if (winner == 0) {
+      flush();
+      out = heads[0]++;
+      out_moved = true;
+    }
+    else {
+      if (run != winner) {
+        flush();
+        run = winner;
+      }
+      run_last = heads[winner]++;
+    }
+
+    if (done(winner)) --active;
+    replay(winner);
+  }
+
+  // The rest of the last source goes as a whole (or just stays there
+  // if that is dst)
+  const size_t winner = tree[0];
+  if (winner == 0 || done(winner)) return flush();
+
+  auto& src = *srcs[winner - 1];
+  if (run != winner) {
+    flush();
+    run = winner;
+  }
+
+  if constexpr (corange<S>) run_last = last(src);
+  else {
+    run_last = heads[winner];
+    for (auto it = ranges::next(run_last); it != ranges::end(src);
+         run_last = it++);
+  }
+
+  flush();
+}
+
+/**
+ * @brief Returns an iterator to the last element before the given
+ *        right limit, starting from a dereferenceable iterator
+ *        preceding it (takes a traversal unless the right limit is a
+ *        bidirectional iterator)
+ **/
+template <typename I, typename S>
+constexpr I last_before(const I it, const S right) {
+  if constexpr (std::same_as<I, S> && std::bidirectional_iterator<I>)
+    return ranges::prev(right);
+  else {
+    auto result = it;
+    for (auto next = ranges::next(result); next != right; result = next++);
+    return result;
+  }
+}
+
+template <typename D, left_limit_of<D> L1, right_limit_of<D> L2,
+          typename S, left_limit_of<S> L3, right_limit_of<S> L4,
+          typename Comp, typename Policy>
+constexpr ranges::borrowed_iterator_t<D> merge_splice
+  (D&& dst, const L1 dst_left, const L2 dst_right,
+   S&& src, const L3 src_left, const L4 src_right,
+   const Comp comp, [[maybe_unused]] const Policy& policy) {
+  auto d = after(dst, dst_left);
+  auto s = after(src, src_left);
+
+  if (s == src_right)
+    return d == dst_right ? d : __detail::last_before(d, dst_right);
+
+  /* The merged elements are (dst_left, pos], and the source runs are
+   * always cut from the front of the source interval, so they are
+   * (src_left, run_last] */
+  ranges::iterator_t<D> pos;
+  bool pos_moved = false;
+
+  const auto put = [&](const auto run_last) {
+    if (pos_moved) cosplice(dst, pos, src, src_left, run_last);
+    else cosplice(dst, dst_left, src, src_left, run_last);
+    pos = run_last;
+    pos_moved = true;
+  };
+
+  if (d == dst_right) {
+    put(__detail::last_before(s, src_right));
+    return pos;
+  }
+
+  for (;;) {
+    // Skip the elements of dst that are not greater than *s, so that
+    // the equivalent ones stay first
+    while (!comp(*s, *d)) {
+      pos = d;
+      pos_moved = true;
+      if (++d == dst_right) {
+        put(__detail::last_before(s, src_right));
+        return pos;
+      }
+    }
+
+    // Now *s < *d, take the whole run of such elements at once
+    auto run_last = s;
+    for (++s; s != src_right && comp(*s, *d); run_last = s++);
+    put(run_last);
+
+    if (s == src_right) return __detail::last_before(d, dst_right);
+  }
+}
+
+template <typename R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename D, typename EqRel>
+constexpr size_t unique_splice(R&& range, const L1 left, const L2 right,
+                               D&& discard, const EqRel is_eq) {
+  auto keep = after(range, left);
+  if (keep == right) return 0;
+
+  // The removed elements are put to the front of discard in their
+  // original order, i.e., they are (before_begin(discard), discard_last]
+  ranges::iterator_t<D> discard_last;
+  bool discard_last_set = false;
+  size_t removed = 0;
+
+  for (auto it = ranges::next(keep); it != right;) {
+    if (!is_eq(*keep, *it)) {
+      keep = it++;
+      continue;
+    }
+
+    // The whole run of the duplicates goes with a single splice
+    auto run_last = it;
+    ++removed;
+    for (++it; it != right && is_eq(*keep, *it); run_last = it++)
+      ++removed;
+
+    if (discard_last_set)
+      cosplice(discard, discard_last, range, keep, run_last);
+    else
+      cosplice(discard, before_begin(discard), range, keep, run_last);
+    discard_last = run_last;
+    discard_last_set = true;
+  }
+
+  return removed;
+}
+
+/**
+ * @brief The engine of the splice-based set operations: merges the
+ *        sorted ranges first and second, and depending on the
+ *        parameters, keeps the elements of first that are not matched
+ *        by the ones of second (_keep_first), puts the unmatched
+ *        elements of second into first (_take_second), and keeps the
+ *        elements of first that are matched (_keep_common). All the
+ *        other elements (including the matched ones of second) are
+ *        put to the front of leftover in their merged order
+ **/
+template <bool _keep_first, bool _take_second, bool _keep_common,
+          typename R1, typename R2, typename R3, typename Comp>
+constexpr void set_operation_splice(R1&& first, R2&& second, R3&& leftover,
+                                    const Comp comp) {
+  using iterator = ranges::iterator_t<R1>;
+
+  // The result is (before_begin(first), pos], the elements of first
+  // after pos and the elements of second are yet to be processed
+  iterator pos, leftover_last;
+  bool pos_moved = false, leftover_moved = false;
+
+  auto it1 = ranges::begin(first);
+  auto it2 = ranges::begin(second);
+  const auto end1 = ranges::end(first);
+  const auto end2 = ranges::end(second);
+
+  const auto keep = [&](const iterator last) {
+    pos = last;
+    pos_moved = true;
+  };
+
+  const auto take = [&](const iterator last) {
+    if (pos_moved)
+      cosplice(first, pos, second, before_begin(second), last);
+    else
+      cosplice(first, before_begin(first), second, before_begin(second), last);
+    keep(last);
+  };
+
+  const auto drop = [&](auto& range, const auto left, const iterator last) {
+    if (leftover_moved) cosplice(leftover, leftover_last, range, left, last);
+    else cosplice(leftover, before_begin(leftover), range, left, last);
+    leftover_last = last;
+    leftover_moved = true;
+  };
+
+  const auto drop_first = [&](const iterator last) {
+    if (pos_moved) drop(first, pos, last);
+    else drop(first, before_begin(first), last);
+  };
+
+  const auto drop_second = [&](const iterator last) {
+    drop(second, before_begin(second), last);
+  };
+
+  while (it1 != end1 && it2 != end2) {
+    auto last1 = it1, last2 = it2;
+
+    const auto order = __detail::weak_order(comp, *it1, *it2);
+    if (order < 0) {
+      // A run of the elements of first less than *it2
+      for (++it1; it1 != end1 && comp(*it1, *it2); last1 = it1++);
+      if constexpr (_keep_first) keep(last1);
+      else drop_first(last1);
+    }
+    else if (order > 0) {
+      // A run of the elements of second less than *it1
+      for (++it2; it2 != end2 && comp(*it2, *it1); last2 = it2++);
+      if constexpr (_take_second) take(last2);
+      else drop_second(last2);
+    }
+    else {
+      // A run of the matched pairs of equivalent elements. If both
+      // halves are dropped, or the unmatched elements of first may be
+      // dropped after them, it must not span several equivalence
+      // classes for leftover to stay sorted
+      for (++it1, ++it2; it1 != end1 && it2 != end2
+             && __detail::weak_order(comp, *it1, *it2) == 0
+             && ((_keep_common && _keep_first) || !comp(*last1, *it1));
+           last1 = it1++, last2 = it2++);
+      if constexpr (_keep_common) keep(last1);
+      else drop_first(last1);
+
+      // The unmatched elements of first equivalent to the matched
+      // ones would be merged before the ones of second
+      if constexpr (!_keep_first) {
+        if (it1 != end1 && !comp(*last2, *it1)) {
+          for (last1 = it1++; it1 != end1 && !comp(*last2, *it1);
+               last1 = it1++);
+          drop_first(last1);
+        }
+      }
+      drop_second(last2);
+    }
+  }
+
+  // The rest of only one of the ranges is left, the one of first can
+  // just stay where it is
+  if constexpr (!_keep_first)
+    if (it1 != end1) drop_first(__detail::last_before(it1, end1));
+
+  if (it2 != end2) {
+    const auto last2 = __detail::last_before(it2, end2);
+    if constexpr (_take_second) take(last2);
+    else drop_second(last2);
+  }
+}
+
+template <typename T, typename Allocator>
+using rebound_vector = std::vector
+  <T, typename std::allocator_traits<std::remove_cvref_t<Allocator>>
+      ::template rebind_alloc<T>>;
+
+template <typename R, typename Proj>
+using group_key_t = std::indirect_result_t<Proj&, ranges::iterator_t<R>>;
+
+/**
+ * @brief An open addressing hash table (with linear probing) mapping
+ *        the hashes of the keys to group indices. The keys themselves
+ *        are not stored, the caller compares them with the ones of
+ *        the groups
+ **/
+template <typename Allocator>
+class group_table {
+public:
+  constexpr static size_t npos = size_t(-1);
+
+  explicit group_table(const Allocator& alloc): slots_(16, alloc) {}
+
+  /**
+   * @brief  Returns the index of the group with the given hash, for
+   *         which is_group(index) is true, or, if there is none,
+   *         registers a new group with the index new_index and
+   *         returns npos
+   **/
+  template <typename F>
+  size_t find_or_add(const size_t hash, const size_t new_index,
+                     const F is_group) {
+    // Keep the load factor under 1/2
+    if (2 * (new_index + 1) > slots_.size()) grow();
+
+    for (size_t idx = home(hash);; idx = (idx + 1) & (slots_.size() - 1)) {
+      auto& s = slots_[idx];
+      if (s.group == npos) {
+        s = { hash, new_index };
+        return npos;
+      }
+      if (s.hash == hash && is_group(s.group)) return s.group;
+    }
+  }
+
+private:
+  struct slot {
+    size_t hash = 0;
+    size_t group = npos;
+  };
+
+  size_t home(const size_t hash) const noexcept {
+    // Fibonacci hashing, so that the poor hashes (like the identity
+    // of std::hash for integers) still spread over the table
+    return size_t((uint64_t(hash) * 0x9E3779B97F4A7C15ull)
+                  >> (64 - std::countr_zero(slots_.size())));
+  }
+
+  void grow() {
+    rebound_vector<slot, Allocator> old(2 * slots_.size(),
+                                        slots_.get_allocator());
+    old.swap(slots_);
+
+    for (const auto& s : old) {
+      if (s.group == npos) continue;
+
+      size_t idx = home(s.hash);
+      while (slots_[idx].group != npos) idx = (idx + 1) & (slots_.size() - 1);
+      slots_[idx] = s;
+    }
+  }
+
+  rebound_vector<slot, Allocator> slots_;
+};
+
+template <typename R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Allocator, typename Proj, typename Hash, typename EqRel>
+rebound_vector<std::pair<size_t, ranges::borrowed_iterator_t<R>>, Allocator>
+  group_by_splice(R&& range, const L1 left, const L2 end, Allocator& alloc,
+                  const Proj& proj, const Hash& hash, const EqRel is_eq) {
+  using iterator = ranges::iterator_t<R>;
+
+  /* The groups are laid out in the order of their first elements,
+   * each one is identified by its size and its last element (which
+   * also serves as the representative of its key). The groups are
+   * built in the prefix (left, lhs], every next run of elements with
+   * equivalent keys either starts a new group right there or is
+   * spliced after the last element of its group */
+  rebound_vector<std::pair<size_t, ranges::borrowed_iterator_t<R>>, Allocator>
+    groups(alloc);
+  group_table<std::remove_cvref_t<Allocator>> table(alloc);
+  iterator lhs;
+
+  for (auto it = after(range, left); it != end;) {
+    size_t size = 1;
+    auto it_last = it;
+    auto it_next = ranges::next(it);
+    for (; it_next != end && is_eq(*it, *it_next); it_last = it_next++)
+      ++size;
+
+    const size_t group =
+      table.find_or_add(std::invoke(hash, std::invoke(proj, *it)),
+                        groups.size(), [&](const size_t idx) {
+                          return is_eq(*groups[idx].second, *it);
+                        });
+
+    if (group == table.npos) {
+      // A new group starts right where we are
+      groups.emplace_back(size, it_last);
+      lhs = it_last;
+    }
+    else {
+      auto& [group_size, group_last] = groups[group];
+      if (group_last == lhs) lhs = it_last;  // Already in place
+      else cosplice(range, group_last, lhs, it_last);
+
+      group_size+= size;
+      group_last = it_last;
+    }
+
+    it = it_next;
+  }
+
+  return groups;
+}
+
+template <typename R, left_limit_of<R> L, typename Comp, typename Policy>
 constexpr ranges::borrowed_iterator_t<R> insertion_sort_splice
-  (R&& range, const L left_limit, size_t size, const Comp comp) {
+  (R&& range, const L left_limit, size_t size, const Comp comp,
+   [[maybe_unused]] const Policy& policy) {
   auto first = after(range, left_limit);
   if (size < 2) [[unlikely]] return first;
 
@@ -111,12 +850,20 @@ constexpr ranges::borrowed_iterator_t<R> insertion_sort_splice
   if (!comp(*rhs, *lhs)) lhs = rhs;
   else {
     cosplice(range, left_limit, lhs);
+    __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
     first = rhs;
   }
 
+  __detail::update_stats(policy, [size](auto& stats) {
+    stats.traversed+= size - 1;
+  });
+
   size-= 2;
   for (; size; --size) {
     rhs = ranges::next(lhs);
+    if constexpr (Policy::prefetch)
+      if (size > 1) __detail::prefetch<Policy>(range, ranges::next(rhs));
+
     // First determine the position of where we can put the rhs
 
     if (!comp(*rhs, *lhs)) {
@@ -132,6 +879,7 @@ constexpr ranges::borrowed_iterator_t<R> insertion_sort_splice
      * this is not a waste of a comparison anyway */
     if (comp(*rhs, *first)) {
       cosplice(range, left_limit, lhs);
+      __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
       first = rhs;
       continue;
     }
@@ -140,19 +888,162 @@ constexpr ranges::borrowed_iterator_t<R> insertion_sort_splice
     // last element on the (sorted left) that is <= *rhs
     auto pos = first;
     for (auto pos_next = ranges::next(pos); !comp(*rhs, *pos_next);
-         pos = pos_next++);
+         pos = pos_next++)
+      __detail::update_stats(policy, [](auto& stats) { ++stats.traversed; });
 
     cosplice(range, pos, lhs);
+    __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
   }
 
   return lhs;
 }
 
-template <typename R, left_limit_of<R> L, typename Comp>
+/**
+ * @brief Calls emit(i, j) for every comparator of Batcher's odd-even
+ *        merge sorting network for size (a power of 2) elements, in
+ *        order. Every comparator puts the lesser element to the lower
+ *        position i < j
+ **/
+template <typename F>
+constexpr void odd_even_merge_network(const size_t size, F&& emit) {
+  for (size_t p = 1; p < size; p*= 2)
+    for (size_t k = p; k > 0; k/= 2)
+      for (size_t j = k % p; j + k < size; j+= 2 * k)
+        for (size_t i = 0; i < std::min(k, size - j - k); ++i)
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+            emit(i + j, i + j + k);
+}
+
+template <size_t _size>
+constexpr auto sorting_network = [] {
+  constexpr size_t comparators = [] {
+    size_t count = 0;
+    __detail::odd_even_merge_network(_size,
+                                     [&count](size_t, size_t) { ++count; });
+    return count;
+  }();
+
+  std::array<std::pair<uint8_t, uint8_t>, comparators> result{};
+  size_t idx = 0;
+  __detail::odd_even_merge_network(_size, [&](const size_t i,
+                                               const size_t j) {
+    result[idx++] = { uint8_t(i), uint8_t(j) };
+  });
+  return result;
+}();
+
+/**
+ * @brief Sorts the corange (left, left + size] of at most _size
+ *        elements with a sorting network and returns its last element
+ *
+ * The iterators are loaded into an array and permuted by the network
+ * (the comparators touching the missing elements are skipped, as if
+ * those were greater than the rest), which makes no branches depending
+ * on the comparisons. The original positions of the elements break the
+ * ties, so the sorting is stable. Then the nodes are relinked in their
+ * original order like in insertion_sort_splice(), but the runs of
+ * elements that end up adjacent are moved with a single splice
+ **/
+template <size_t _size, typename R, left_limit_of<R> L,
+          typename Comp, typename Policy>
+constexpr ranges::borrowed_iterator_t<R> network_sort_splice
+  (R&& range, const L left, const size_t size, const Comp comp,
+   [[maybe_unused]] const Policy& policy) {
+  static_assert(_size <= 256, "The positions are stored in bytes");
+  if (size < 2) [[unlikely]] return after(range, left);
+
+  std::array<ranges::iterator_t<R>, _size> its;
+  std::array<uint8_t, _size> pos;  // The original positions
+
+  its[0] = after(range, left);
+  pos[0] = 0;
+  for (size_t i = 1; i < size; ++i) {
+    its[i] = ranges::next(its[i - 1]);
+    pos[i] = uint8_t(i);
+  }
+  __detail::update_stats(policy, [size](auto& stats) {
+    stats.traversed+= size - 1;
+  });
+
+  for (const auto& [i, j] : __detail::sorting_network<_size>) {
+    if (j >= size) continue;
+
+    // The element at j goes first iff it is less or, being
+    // equivalent, was the first originally
+    const bool j_first = pos[j] < pos[i];
+    const auto lhs = j_first ? its[i] : its[j];
+    const auto rhs = j_first ? its[j] : its[i];
+    const bool swap = comp(*lhs, *rhs) != j_first;
+
+    const auto it_i = its[i], it_j = its[j];
+    const auto pos_i = pos[i], pos_j = pos[j];
+    its[i] = swap ? it_j : it_i;
+    its[j] = swap ? it_i : it_j;
+    pos[i] = swap ? pos_j : pos_i;
+    pos[j] = swap ? pos_i : pos_j;
+  }
+
+  std::array<uint8_t, _size> rank;  // The sorted positions
+  for (size_t r = 0; r < size; ++r) rank[pos[r]] = uint8_t(r);
+
+  /* Now go through the elements in their original order, keeping the
+   * processed ones sorted: the one ranked highest so far (tail) is
+   * always the last of them, followed by the rest */
+  size_t tail = 0;
+  for (size_t k = 1; k < size;) {
+    if (rank[k] > rank[tail]) {
+      tail = k++;
+      continue;
+    }
+
+    // The following elements that go right after this one are moved
+    // together (none of them can go after the tail)
+    size_t last = k;
+    while (last + 1 < size && rank[last + 1] == rank[last] + 1) ++last;
+
+    // They go after the processed element ranked highest below them
+    size_t r = rank[k];
+    while (r > 0 && pos[r - 1] >= k) --r;
+
+    if (r == 0) cosplice(range, left, its[rank[tail]], its[rank[last]]);
+    else
+      cosplice(range, its[r - 1], its[rank[tail]], its[rank[last]]);
+    __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
+
+    k = last + 1;
+  }
+
+  return its[size - 1];
+}
+
+// The size of the runs the merge sorts start from
+template <typename Policy>
+constexpr size_t merge_sort_leaf =
+  Policy::network_leaf_size > 0 ? Policy::network_leaf_size : 4;
+
+/**
+ * @brief Sorts a run the merge sorts start from (of at most
+ *        merge_sort_leaf<Policy> elements), with the sorting network
+ *        if the policy enables it (see Policy::network_leaf_size)
+ **/
+template <typename R, left_limit_of<R> L, typename Comp, typename Policy>
+constexpr ranges::borrowed_iterator_t<R> merge_sort_leaf_splice
+  (R&& range, const L left, const size_t size, const Comp comp,
+   const Policy& policy) {
+  if constexpr (Policy::network_leaf_size > 0)
+    return __detail::network_sort_splice<Policy::network_leaf_size>
+      (std::forward<R>(range), left, size, comp, policy);
+  else
+    return __detail::insertion_sort_splice(std::forward<R>(range), left,
+                                           size, comp, policy);
+}
+
+template <typename R, left_limit_of<R> L, typename Comp, typename Policy>
 constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
-  (R&& range, const L left, const size_t size, const Comp comp) {
-  constexpr size_t MergeThreshold = 4; // Use insertions if smaller
-                                       // (must be a power of 2)
+  (R&& range, const L left, const size_t size, const Comp comp,
+   const Policy& policy) {
+  // Sort the leaves if smaller (must be a power of 2)
+  constexpr size_t MergeThreshold = __detail::merge_sort_leaf<Policy>;
 
   /* Let L = ceil(log2(size+1)) and S(k) = size >> (L-k).
    * At step k we assume that the first S(k) elements are already
@@ -162,15 +1053,20 @@ constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
    * next step.
    * This approach gives the most balanced division. Obviously, after
    * step L-1 is finished, the range is sorted.
-   * If T = log2(MergeThreshold), then we can apply insertion sort to
-   * the first S(T) elements and then start with k=T */
+   * If T = log2(MergeThreshold), then we can apply insertion sort (or
+   * the sorting network) to the first S(T) elements and then start
+   * with k=T */
   const size_t max_steps = 64 - std::countl_zero(uint64_t(size)); // L
   constexpr size_t first_step = std::countr_zero(MergeThreshold); // T
 
+  const stats_depth_guard depth_guard(policy);
+  __detail::update_stats(policy, [](auto& stats) { ++stats.runs; });
+
   size_t l_cnt = max_steps <= first_step ? size
     : size >> (max_steps - first_step);
   auto last_sorted =
-    __detail::insertion_sort_splice(std::forward<R>(range), left, l_cnt, comp);
+    __detail::merge_sort_leaf_splice(std::forward<R>(range), left, l_cnt,
+                                     comp, policy);
 
   // Invariant: [begin(range), last_sorted] is already sorted and
   // contains l_cnt elements
@@ -179,11 +1075,12 @@ constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
 
     const auto last_sorted_right =
       __detail::merge_sort_splice(std::forward<R>(range),
-                                  last_sorted, to_sort, comp);
+                                  last_sorted, to_sort, comp, policy);
 
     last_sorted =
       __detail::coinplace_merge_splice(std::forward<R>(range), left,
-                                       last_sorted, last_sorted_right, comp);
+                                       last_sorted, last_sorted_right,
+                                       comp, policy);
 
     l_cnt+= to_sort;
   }
@@ -191,177 +1088,1750 @@ constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
   return last_sorted;
 }
 
-template <size_t _max_buckets, typename R>
-using bucket_sort_splice_data =
-  flat_list<std::pair<size_t, ranges::iterator_t<R>>, _max_buckets>;
-
-template <size_t _max_buckets, typename R, typename Allocator>
-constexpr auto allocate_bucket_sort_splice_data(Allocator&& alloc) {
-  // We need a proper smart pointer here in case exception is thrown
-  // from the main sorting function
-  using data_t = bucket_sort_splice_data<_max_buckets, R>;
-  using traits = std::allocator_traits<std::remove_reference_t<Allocator>>
-    ::template rebind_traits<data_t>;
+template <typename R, left_limit_of<R> L, typename Comp, typename Policy>
+constexpr ranges::borrowed_iterator_t<R> partial_sort_splice
+  (R&& range, const L left, const size_t size, const size_t k,
+   const Comp comp, const Policy& policy) {
+  if (k >= size)
+    return __detail::merge_sort_splice(range, left, size, comp, policy);
+  if (k == 0) return after(range, left);
+
+  /* The k smallest elements seen so far are kept sorted in (left,
+   * tail]. The elements less than *tail are the candidates: they are
+   * gathered into a batch (tail, batch_last] right after it, and once
+   * there are k of them, the batch is sorted and merged into the
+   * prefix, whose last k elements are then dropped (i.e., they just
+   * stay after the new tail). Every element gets into at most one
+   * batch, so that takes O(n log k) comparisons overall, and only one
+   * per element once the prefix has the smallest ones.
+   * The rejected elements stay in place, so prev (the last element
+   * scanned) is either one of them or batch_last */
+  auto tail = __detail::merge_sort_splice(range, left, k, comp, policy);
+  auto batch_last = tail;
+  auto prev = tail;
+  size_t batch_size = 0;
+
+  const auto merge_batch = [&]() {
+    const bool adjacent = prev == batch_last;
+
+    batch_last =
+      __detail::merge_sort_splice(range, tail, batch_size, comp, policy);
+    batch_last =
+      __detail::coinplace_merge_splice(range, left, tail, batch_last,
+                                       comp, policy);
+    if (adjacent) prev = batch_last;
+
+    tail = ranges::next(after(range, left), k - 1);
+    batch_last = tail;
+    batch_size = 0;
+  };
+
+  for (size_t scanned = k; scanned < size; ++scanned) {
+    const auto it = ranges::next(prev);
+    if constexpr (Policy::prefetch) {
+      if (scanned + 1 < size)
+        __detail::prefetch<Policy>(range, ranges::next(it));
+    }
 
-  typename traits::allocator_type real_alloc{std::forward<Allocator>(alloc)};
+    if (!comp(*it, *tail)) {
+      prev = it;
+      continue;
+    }
 
-  auto data_ptr = real_alloc.allocate(1);
-  traits::construct(real_alloc, data_ptr);
+    if (prev == batch_last) prev = it;
+    else cosplice(range, batch_last, prev, it);
+    batch_last = it;
 
-  auto deleter =
-    [real_alloc = std::move(real_alloc)](data_t* const ptr) mutable {
-      traits::destroy(real_alloc, ptr);
-      real_alloc.deallocate(ptr, 1);
-    };
+    if (++batch_size == k) merge_batch();
+  }
 
-  return
-    std::unique_ptr<data_t, decltype(deleter)>(data_ptr, std::move(deleter));
+  if (batch_size > 0) merge_batch();
+  return tail;
 }
 
-template <size_t _max_buckets,
-          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
-          typename EqRel, typename Comp>
-constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
-  (R&& range, const L1 left, const L2 end, const EqRel is_eq, const Comp comp,
-   bucket_sort_splice_data<_max_buckets, R>& memory) {
-  static_assert(_max_buckets > 0);
-  auto lhs = after(range, left);  // Rightmost bucketed
-  if (lhs == end) return std::make_pair(0, lhs);
-  // Okay, that was nasty, but now we know the range has something
+/**
+ * @brief Partitions the corange (left, left + size] into three parts
+ *        by splicing: the elements less than *lo, followed by the ones
+ *        in [*lo, *hi], followed by the ones greater than *hi (which
+ *        stay in place). The partition is stable. Calls visit(i, it,
+ *        part) for the i-th element (in the original order) after
+ *        putting it into its part (0, 1 or 2)
+ * @return The sizes and the last elements of the first two parts (the
+ *         last elements are unspecified for empty parts)
+ **/
+template <typename R, left_limit_of<R> L, typename Comp,
+          typename Visit, typename Policy>
+constexpr auto three_way_partition_splice
+  (R&& range, const L left, const size_t size,
+   const ranges::iterator_t<R> lo, const ranges::iterator_t<R> hi,
+   const Comp comp, Visit&& visit, [[maybe_unused]] const Policy& policy) {
+  // The processed elements are (left, cur]
+  const auto first = after(range, left);
+  auto less_last = first, mid_last = first, cur = first;
+  size_t less_size = 0, mid_size = 0;
+  bool greater_seen = false;
+
+  const auto put = [&](const size_t i, const auto it) {
+    if (comp(*it, *lo)) {
+      if (mid_size == 0 && !greater_seen) cur = it;
+      else if (less_size == 0) cosplice(range, left, cur, it);
+      else cosplice(range, less_last, cur, it);
+      less_last = it;
+      ++less_size;
+      visit(i, it, 0);
+    }
+    else if (!comp(*hi, *it)) {
+      if (!greater_seen) cur = it;
+      else if (mid_size > 0) cosplice(range, mid_last, cur, it);
+      else if (less_size == 0) cosplice(range, left, cur, it);
+      else cosplice(range, less_last, cur, it);
+      mid_last = it;
+      ++mid_size;
+      visit(i, it, 1);
+    }
+    else {
+      greater_seen = true;
+      cur = it;
+      visit(i, it, 2);
+    }
+  };
 
-  /* First, traverse the range to fill the buckets up. Our flat_list
-   * contains the size of the bucket and an iterator to its last
-   * element.
-   * Invariant: if a bucket with b precedes the one with c in the
-   * range then c >= b */
+  put(0, first);
+  for (size_t i = 1; i < size; ++i) {
+    if constexpr (Policy::prefetch) {
+      if (i + 1 < size)
+        __detail::prefetch<Policy>(range, ranges::next(ranges::next(cur)));
+    }
 
-  // The first element always has its own bucket
-  auto last_buck = memory.emplace_after(memory.before_begin(), 1, lhs);
+    put(i, ranges::next(cur));
+  }
 
-  // If the range has more equivalency classes than _max_buckets, we
-  // will put them in the last bucket and inplace_merge later
-  bool last_buck_dirty = false;
+  return std::make_tuple(less_size, less_last, mid_size, mid_last);
+}
 
-  for (auto it = ranges::next(lhs); it != end;) {
-     // We deal with the last bucket separately
-    if (is_eq(*it, *last_buck->second)) {
-      // No need for splicing, just fast forward
-      ++last_buck->first;
-      last_buck->second = it;
-      lhs = it++;
-      continue;
+template <typename R>
+using nth_element_sample = std::array<ranges::iterator_t<R>, 256>;
+
+template <typename R, left_limit_of<R> L, typename Comp, typename Policy>
+constexpr ranges::borrowed_iterator_t<R> nth_element_splice
+  (R&& range, const L left, const size_t size, const size_t n,
+   const size_t depth, const Comp comp, nth_element_sample<R>& sample,
+   const Policy& policy) {
+  constexpr size_t SortThreshold = 32; // Just sort if not greater
+
+  if (size <= SortThreshold || depth == 0) {
+    // The depth limit is only exceeded with bad pivots, fall back to
+    // merge sort (like introselect does) in that case
+    __detail::merge_sort_splice(range, left, size, comp, policy);
+    return ranges::next(after(range, left), n);
+  }
+
+  /* Traversals are what is expensive here, so we take a sample of
+   * evenly spaced elements and choose two pivots from it, so that the
+   * n-th element falls between them with high probability, but there
+   * are only a few elements in between (like in the Floyd-Rivest
+   * algorithm). The bounds are about 2 standard deviations (of the
+   * rank in the sample) away from the expected rank */
+  const size_t samples = std::min(sample.size(), size / 4);
+  const size_t stride = size / samples;
+  const size_t spread = size_t{1} << (std::bit_width(samples) / 2);
+
+  auto it = ranges::next(after(range, left), stride / 2);
+  for (size_t i = 0; i < samples; ++i) {
+    sample[i] = it;
+    if (i + 1 < samples) {
+      for (size_t j = 0; j < stride; ++j) {
+        if constexpr (Policy::prefetch) {
+          if (j + 1 < stride)
+            __detail::prefetch<Policy>(range, ranges::next(it));
+        }
+        ++it;
+      }
     }
+  }
 
-    const bool can_add_buckets = memory.size() < _max_buckets;
+  std::sort(sample.begin(), sample.begin() + samples,
+            [&comp](const auto lhs, const auto rhs) {
+              return comp(*lhs, *rhs);
+            });
+
+  const size_t rank = n * samples / size;
+  auto lo = sample[rank > spread ? rank - spread : 0];
+  auto hi = sample[std::min(rank + spread, samples - 1)];
+
+  const auto partition = [&]() {
+    return __detail::three_way_partition_splice(range, left, size, lo, hi,
+                                                comp, [](size_t, auto, int) {},
+                                                policy);
+  };
+
+  auto parts = partition();
+  if (std::get<2>(parts) == size && comp(*lo, *hi)) {
+    // Nothing is left out with many equivalent elements around the
+    // n-th one, so partition around a single pivot instead
+    lo = hi = sample[rank];
+    parts = partition();
+  }
 
-    /* Okay, the element is not in the last bucket, but we might still
-     * get away with no splicing: if the element is greater than the
-     * representative, it cannot be in any bucket preceding this one
-     * because of the invariant and the consistency. Therefore we will
-     * need to start another bucket right here */
-    if (comp(*last_buck->second, *it)) {
-      if (can_add_buckets)
-        last_buck = memory.emplace_after(last_buck, 1, it);
-      else {
-        // Put the unbucketed in the last bucket still (note that the
-        // last bucket cannot change after the maximum is reached)
-        ++last_buck->first;
-        last_buck_dirty = true;
-      }
+  const auto [less_size, less_last, mid_size, mid_last] = parts;
 
-      lhs = it++;
-      continue;
-    }
+  // The pivots are in [lo, hi] themselves, so mid_size > 0
+  if (n < less_size)
+    return __detail::nth_element_splice(range, left, less_size, n,
+                                        depth - 1, comp, sample, policy);
 
-    // Fine, we need to check other buckets and splice. First decide
-    // how many elements go, so we can optimize the splicing a little
-    size_t size_to_bucket = 1;
-    auto it_last = it;
-    auto it_next = ranges::next(it);
+  if (n < less_size + mid_size) {
+    const auto mid_first =
+      less_size == 0 ? after(range, left) : ranges::next(less_last);
+
+    // All the elements in the middle are equivalent if the pivots are
+    if (!comp(*lo, *hi)) return ranges::next(mid_first, n - less_size);
+
+    if (less_size == 0)
+      return __detail::nth_element_splice(range, left, mid_size, n,
+                                          depth - 1, comp, sample, policy);
+    return __detail::nth_element_splice(range, less_last, mid_size,
+                                        n - less_size,
+                                        depth - 1, comp, sample, policy);
+  }
+
+  return __detail::nth_element_splice(range, mid_last,
+                                      size - less_size - mid_size,
+                                      n - less_size - mid_size,
+                                      depth - 1, comp, sample, policy);
+}
+
+/**
+ * @brief A few elements of a part of a range, evenly spaced, that the
+ *        pivot for the part is chosen from
+ **/
+template <typename R>
+struct quick_sort_sample {
+  std::array<ranges::iterator_t<R>, 16> elements;
+  size_t size = 0;
+
+  constexpr void push(const ranges::iterator_t<R> it) noexcept {
+    if (size < elements.size()) elements[size++] = it;
+  }
+};
+
+template <typename R, left_limit_of<R> L, typename Comp, typename Policy>
+constexpr ranges::borrowed_iterator_t<R> quick_sort_splice
+  (R&& range, const L left, const size_t size, const size_t depth,
+   const Comp comp, quick_sort_sample<R> sample, const Policy& policy) {
+  constexpr size_t SortThreshold = 32; // Merge sort if not greater
+  constexpr size_t MinSample = 3;
+
+  if (size <= SortThreshold || depth == 0)
+    return __detail::merge_sort_splice(range, left, size, comp, policy);
+
+  const size_t capacity = sample.elements.size();
+  const size_t stride = size / capacity;
+
+  if (sample.size < MinSample) {
+    /* Only happens on the top level (or with very unbalanced parts),
+     * otherwise the sample is gathered while partitioning the parent.
+     * Walking the whole part just for that would cost as much as a
+     * partitioning pass, so we take the sample from its prefix. If
+     * the prefix is not representative, we'll only get an unbalanced
+     * partition, and the next level will have a proper sample */
+    const size_t prefix_stride = std::min(size / capacity, capacity);
+    sample.size = 0;
+    auto it = ranges::next(after(range, left), prefix_stride / 2);
+    for (size_t i = 0; i < capacity; ++i) {
+      sample.push(it);
+      if (i + 1 < capacity) it = ranges::next(it, prefix_stride);
+    }
+  }
+
+  const auto sample_first = sample.elements.begin();
+  const auto sample_last = sample_first + sample.size;
+  std::sort(sample_first, sample_last,
+            [&comp](const auto lhs, const auto rhs) {
+              return comp(*lhs, *rhs);
+            });
+
+  /* Partitioning only beats merge sort when it gets rid of many
+   * equivalent elements at once (as every pass over a linked range
+   * is a traversal), so if there are no equivalent elements in the
+   * sample, the part is most likely better off merge sorted */
+  if (std::adjacent_find(sample_first, sample_last,
+                         [&comp](const auto lhs, const auto rhs) {
+                           return !comp(*lhs, *rhs);
+                         }) == sample_last)
+    return __detail::merge_sort_splice(range, left, size, comp, policy);
+
+  const auto pivot = sample.elements[sample.size / 2];
+
+  /* Take every stride-th element of the less and the greater parts
+   * into their samples, so the next level doesn't need an additional
+   * traversal to choose the pivots (that is what the cost is dominated
+   * by). No more than capacity elements are taken overall */
+  quick_sort_sample<R> less_sample, greater_sample;
+  const auto [less_size, less_last, mid_size, mid_last] =
+    __detail::three_way_partition_splice
+      (range, left, size, pivot, pivot, comp,
+       [&, next = stride / 2](const size_t i, const auto it,
+                              const int part) mutable {
+         if (i != next) return;
+         if (part == 0) less_sample.push(it);
+         else if (part == 2) greater_sample.push(it);
+         next+= stride;
+       }, policy);
+
+  // The pivot itself is in the middle part, so mid_size > 0 and the
+  // elements in it need no sorting
+  if (less_size > 0)
+    __detail::quick_sort_splice(range, left, less_size, depth - 1,
+                                comp, less_sample, policy);
+
+  const size_t greater_size = size - less_size - mid_size;
+  if (greater_size == 0) return mid_last;
+  return __detail::quick_sort_splice(range, mid_last, greater_size,
+                                     depth - 1, comp, greater_sample, policy);
+}
+
+/**
+ * @brief A stack of sorted runs that immediately follow each other
+ *        (and the given left limit) in a range. Each run is
+ *        identified by its size and its last element, so that the
+ *        left limit of a run is the last element of the previous one
+ **/
+template <typename R, typename L, size_t _capacity>
+class run_stack {
+public:
+  using iterator = ranges::iterator_t<R>;
+
+  struct run {
+    size_t size;
+    iterator last;
+  };
+
+  constexpr run_stack(const L left) noexcept: left_(left) {}
+
+  constexpr size_t size() const noexcept {
+    return size_;
+  }
+
+  constexpr run& operator[](const size_t idx) noexcept {
+    return runs_[idx];
+  }
+
+  constexpr run& top() noexcept {
+    return runs_[size_ - 1];
+  }
+
+  template <typename Policy>
+  constexpr void push(const size_t size, const iterator last,
+                      const Policy& policy) noexcept {
+    runs_[size_++] = { size, last };
+    __detail::update_stats(policy, [this](auto& stats) {
+      stats.max_depth = std::max(stats.max_depth, size_);
+      ++stats.runs;
+    });
+  }
+
+  /**
+   * @brief Calls the given function with the left limit of the run
+   *        following the first idx runs (i.e., with the front limit
+   *        itself if idx is zero)
+   **/
+  template <typename F>
+  constexpr decltype(auto) with_left(const size_t idx, F&& func) const {
+    if (idx == 0) return std::forward<F>(func)(left_);
+    else return std::forward<F>(func)(runs_[idx - 1].last);
+  }
+
+  /**
+   * @brief Merges the runs idx and (idx + 1) into one
+   **/
+  template <typename Comp, typename Policy>
+  constexpr void merge_at(R& range, const size_t idx,
+                          const Comp comp, const Policy& policy) {
+    run& lhs = runs_[idx];
+    const run& rhs = runs_[idx + 1];
+
+    lhs.last = with_left(idx, [&](const auto left) {
+      return __detail::coinplace_merge_splice(range, left,
+                                              lhs.last, rhs.last,
+                                              comp, policy);
+    });
+    lhs.size+= rhs.size;
+
+    for (size_t i = idx + 1; i + 1 < size_; ++i)
+      runs_[i] = runs_[i + 1];
+    --size_;
+  }
+
+  /**
+   * @brief Merges all the runs (from the top of the stack) into one
+   *        and returns it. The stack must not be empty
+   **/
+  template <typename Comp, typename Policy>
+  constexpr run collapse(R& range, const Comp comp, const Policy& policy) {
+    while (size_ > 1) merge_at(range, size_ - 2, comp, policy);
+    return runs_[0];
+  }
+
+private:
+  L left_;
+  size_t size_ = 0;
+  run runs_[_capacity];
+};
+
+template <typename R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> merge_sort_splice
+  (R&& range, const L1 left, const L2 end, const Comp comp,
+   const Policy& policy) {
+  // Size of the initial runs
+  constexpr size_t MergeThreshold = __detail::merge_sort_leaf<Policy>;
+
+  auto next = after(range, left);
+  if (next == end) return std::make_pair(0, next);
+
+  /* Cut the interval into runs of MergeThreshold elements in one
+   * forward pass, sorting them with insertions (or the sorting
+   * network), and push them into the stack. Two top runs are merged
+   * when the lower one is not bigger, thus the stack acts as a
+   * binary counter: all the sizes but the top one are distinct
+   * powers of 2 multiplied by MergeThreshold, and 64 runs is always
+   * enough */
+  run_stack<R, L1, 64> runs{left};
+
+  do {
+    size_t count = 0;
+    for (; count < MergeThreshold && next != end; ++count, ++next);
+    __detail::update_stats(policy, [count](auto& stats) {
+      stats.traversed+= count;
+    });
+
+    const auto last = runs.with_left(runs.size(), [&](const auto run_left) {
+      return __detail::merge_sort_leaf_splice(range, run_left, count,
+                                              comp, policy);
+    });
+    runs.push(count, last, policy);
+
+    while (runs.size() > 1
+           && runs[runs.size() - 2].size <= runs.top().size)
+      runs.merge_at(range, runs.size() - 2, comp, policy);
+  }
+  while (next != end);
+
+  const auto result = runs.collapse(range, comp, policy);
+  return std::make_pair(result.size, result.last);
+}
+
+template <typename R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+  natural_merge_sort_splice(R&& range, const L1 left, const L2 end,
+                            const Comp comp, const Policy& policy) {
+  constexpr size_t MinRun = 4; // Extend shorter runs with insertions
+
+  auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  /* We maintain the TimSort invariants on the stack (with the fix
+   * from CPython's merge_collapse, so that they hold for every run):
+   * (1) size[i-2] > size[i-1] + size[i];
+   * (2) size[i-1] > size[i].
+   * That makes the sizes grow at least as fast as the Fibonacci
+   * numbers, so 128 runs is always enough. Note that we cannot use
+   * powersort's merge policy here since it requires the total size */
+  run_stack<R, L1, 128> runs{left};
+
+  do {
+    const size_t top = runs.size();
+
+    size_t size = 1;
+    auto last = first;
+    auto next = ranges::next(first);
+
+    if (next != end) {
+      if (comp(*next, *first)) {
+        // A strictly descending run: reverse it by moving every next
+        // element to the front (this keeps the sorting stable)
+        auto front = first;
+        do {
+          runs.with_left(top, [&](const auto run_left) {
+            cosplice(range, run_left, last);
+          });
+          __detail::update_stats(policy, [](auto& stats) {
+            ++stats.splices;
+          });
+          front = next;
+          ++size;
+
+          next = ranges::next(last);
+        }
+        while (next != end && comp(*next, *front));
+      }
+      else {
+        do {
+          last = next++;
+          ++size;
+        }
+        while (next != end && !comp(*next, *last));
+      }
+    }
+
+    __detail::update_stats(policy, [size](auto& stats) {
+      stats.traversed+= size;
+    });
+
+    if (size < MinRun && next != end) {
+      // The run is too short, so extend it with insertions to avoid
+      // the merging overhead on random data
+      do {
+        ++next;
+        ++size;
+      }
+      while (size < MinRun && next != end);
+
+      last = runs.with_left(top, [&](const auto run_left) {
+        return __detail::insertion_sort_splice(range, run_left, size,
+                                               comp, policy);
+      });
+    }
+
+    runs.push(size, last, policy);
+    first = next;
+
+    // Restore the invariants
+    while (runs.size() > 1) {
+      size_t idx = runs.size() - 2;
+      const auto size_at = [&runs](const size_t i) { return runs[i].size; };
+
+      if ((idx > 0 && size_at(idx - 1) <= size_at(idx) + size_at(idx + 1))
+          || (idx > 1 && size_at(idx - 2) <= size_at(idx - 1) + size_at(idx))) {
+        if (size_at(idx - 1) < size_at(idx + 1)) --idx;
+      }
+      else if (size_at(idx) > size_at(idx + 1)) break;
+
+      runs.merge_at(range, idx, comp, policy);
+    }
+  }
+  while (first != end);
+
+  // Finally, merge everything that's left, smaller runs first
+  while (runs.size() > 1) {
+    size_t idx = runs.size() - 2;
+    if (idx > 0 && runs[idx - 1].size < runs[idx + 1].size) --idx;
+    runs.merge_at(range, idx, comp, policy);
+  }
+
+  return std::make_pair(runs[0].size, runs[0].last);
+}
+
+/**
+ * @brief A bucket filled by bucket_sort_distribute(): the elements
+ *        (prev.last, last], where prev is the preceding bucket
+ **/
+template <typename I>
+struct sort_bucket {
+  size_t size;
+  I last;
+};
+
+/**
+ * @brief A bucket that can be merged with its neighbours (see
+ *        bucket_sort_distribute_merging()). It also remembers its
+ *        first element, which stays in place as the others are added
+ **/
+template <typename I>
+struct merging_sort_bucket {
+  size_t size;
+  I last;
+  I first;
+  bool merged = false;  // Whether it holds more than one class
+};
+
+template <typename R, bool _merging>
+using bucket_sort_entry =
+  std::conditional_t<_merging, merging_sort_bucket<ranges::iterator_t<R>>,
+                     sort_bucket<ranges::iterator_t<R>>>;
+
+template <size_t _max_buckets, typename R, bool _merging = false>
+using bucket_sort_splice_data =
+  flat_ranked_list<bucket_sort_entry<R, _merging>, _max_buckets>;
+
+// The bucket data with the capacity chosen at runtime
+template <typename R, typename Allocator, bool _merging = false>
+using dynamic_bucket_sort_splice_data =
+  ranked_list<bucket_sort_entry<R, _merging>, Allocator>;
+
+// The runtime bucket counts up to this one are served from the stack
+constexpr size_t bucket_sort_inline_buckets = 32;
+
+/**
+ * @brief Allocates and constructs an object of type Data (the
+ *        additional memory for an algorithm) with the given allocator
+ **/
+template <typename Data, typename Allocator>
+constexpr auto allocate_sort_data(Allocator&& alloc) {
+  // We need a proper smart pointer here in case exception is thrown
+  // from the main sorting function
+  using data_t = Data;
+  using traits = std::allocator_traits<std::remove_reference_t<Allocator>>
+    ::template rebind_traits<data_t>;
+
+  typename traits::allocator_type real_alloc{std::forward<Allocator>(alloc)};
+
+  auto data_ptr = real_alloc.allocate(1);
+  traits::construct(real_alloc, data_ptr);
+
+  auto deleter =
+    [real_alloc = std::move(real_alloc)](data_t* const ptr) mutable {
+      traits::destroy(real_alloc, ptr);
+      real_alloc.deallocate(ptr, 1);
+    };
+
+  return
+    std::unique_ptr<data_t, decltype(deleter)>(data_ptr, std::move(deleter));
+}
+
+template <typename A>
+concept allocator_like = requires(A& alloc) {
+  typename A::value_type;
+  alloc.allocate(size_t{1});
+};
+
+/**
+ * @brief Merges the runs of adjacent buckets that are small relative
+ *        to the average (see bucket_sort_distribute())
+ * @return True iff at least one bucket has been freed
+ **/
+template <typename Buckets, typename Policy>
+constexpr bool bucket_sort_merge_sparse(Buckets& memory, const size_t total,
+                                        [[maybe_unused]] const Policy& policy) {
+  /* A run is merged as long as it holds no more than 3 average
+   * buckets. Then any two resulting neighbours hold more than that,
+   * so at most 2/3 of the buckets remain (and, if there are two or
+   * more, at least one is always freed) */
+  const size_t capacity = memory.capacity();
+  const size_t threshold = (3 * total + capacity - 1) / capacity;
+  const size_t buckets = memory.size();
+
+  memory.merge_adjacent([threshold](auto& lhs, auto& rhs) {
+    if (lhs.size + rhs.size > threshold) return false;
+
+    rhs.size+= lhs.size;
+    rhs.first = lhs.first;
+    rhs.merged = true;
+    return true;
+  });
+
+  __detail::update_stats(policy, [&memory, buckets](auto& stats) {
+    stats.bucket_merges+= buckets - memory.size();
+  });
+  return memory.size() < buckets;
+}
+
+/**
+ * @brief  The first phase of the bucket sort with merging (see
+ *         Policy::merge_buckets): distributes the elements of the
+ *         (non-empty) interval (left, end) into consecutive buckets
+ *         like the version below, but once there are no free buckets
+ *         left, merges the sparse ones to make room for the new
+ *         classes
+ * @return False, since the last bucket is never dirty
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Comp, typename Buckets, typename Policy>
+  requires(Policy::merge_buckets)
+constexpr bool bucket_sort_distribute
+  (R&& range, const L1 left, const L2 end, const EqRel is_eq, const Comp comp,
+   Buckets& memory, [[maybe_unused]] const Policy& policy) {
+  auto lhs = after(range, left);  // Rightmost bucketed
+
+  /* A bucket holds either a single equivalence class, or (once it is
+   * merged) all the elements between its first one and the first one
+   * of the next bucket. Either way, the elements of a bucket are not
+   * less than its first one, so the first elements are ordered and
+   * can be binary searched */
+  auto last_buck =
+    memory.emplace_after(memory.before_begin(), size_t{1}, lhs, lhs);
+  const size_t max_buckets = memory.capacity();
+  size_t total = 1;
+
+  for (auto it = ranges::next(lhs); it != end;) {
+    if constexpr (Policy::prefetch) {
+      const auto it_next = ranges::next(it);
+      if (it_next != end) __detail::prefetch<Policy>(range, it_next);
+    }
+
+    /* The last bucket follows lhs, so it grows with no splicing if
+     * the element is in its class or, once it is merged, greater. An
+     * element greater than its class starts a new last bucket, if
+     * there is room for one (the comparator is only called if the
+     * element is not in the class, unless it is three-way) */
+    const auto order =
+      __detail::bucket_order(is_eq, comp, *it, *last_buck->last);
+    if (order == 0 || (order > 0 && last_buck->merged)) {
+      ++last_buck->size;
+      last_buck->last = it;
+      lhs = it++;
+      ++total;
+      continue;
+    }
+
+    if (order > 0 && memory.size() < max_buckets) {
+      last_buck = memory.emplace_after(last_buck, size_t{1}, it, it);
+      lhs = it++;
+      ++total;
+      continue;
+    }
+
+    size_t size_to_bucket = 1;
+    auto it_last = it;
+    auto it_next = ranges::next(it);
+    for (; it_next != end && is_eq(*it, *it_next); it_last = it_next++)
+      ++size_to_bucket;
+    total+= size_to_bucket;
+
+    while (true) {
+      /* An equivalence class is an interval of the order, so the
+       * first elements are less than, in the class of, or greater
+       * than *it in that order. Look for the bucket starting with its
+       * class, or else find the number of the buckets starting before
+       * it (one comparison per step, if the comparator is three-way) */
+      auto buck = memory.end();
+      size_t lo = 0, hi = memory.size();
+      while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const auto order =
+          __detail::bucket_order(is_eq, comp, *it, *memory.nth(mid)->first);
+
+        if (order == 0) {
+          buck = memory.nth(mid);
+          lo = mid;
+          break;
+        }
+
+        if (order > 0) lo = mid + 1;
+        else hi = mid;
+      }
+
+      // Otherwise the elements belong to the bucket starting before
+      // them if it has been merged
+      if (buck == memory.end() && lo > 0) {
+        const auto buck_prev = memory.nth(lo - 1);
+        if (buck_prev->merged) buck = buck_prev;
+      }
+
+      if (buck == memory.end() && memory.size() == max_buckets) {
+        if (__detail::bucket_sort_merge_sparse(memory, total, policy)) {
+          // Some buckets are free now, look for the place once again
+          last_buck = memory.nth(memory.size() - 1);
+          continue;
+        }
+
+        // Nothing can be merged (i.e., there is a single bucket), so
+        // the bucket starting before the elements has to take them.
+        // If there is none, the first one takes them instead
+        if (lo == 0) {
+          const auto first_buck = memory.begin();
+          cosplice(range, left, lhs, it_last);
+          __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
+
+          first_buck->size+= size_to_bucket;
+          first_buck->first = it;
+          first_buck->merged = true;
+          break;
+        }
+
+        buck = memory.nth(lo - 1);
+        buck->merged = true;
+      }
+
+      if (buck != memory.end()) {
+        if (buck == last_buck) lhs = it_last;
+        else {
+          cosplice(range, buck->last, lhs, it_last);
+          __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
+        }
+
+        buck->size+= size_to_bucket;
+        buck->last = it_last;
+      }
+      else if (lo == memory.size()) {
+        // Greater than everything so far, no splicing needed
+        last_buck = memory.emplace_after(last_buck, size_to_bucket,
+                                         it_last, it);
+        lhs = it_last;
+      }
+      else {
+        // The new bucket goes before the last one (at rank lo)
+        ++last_buck;
+
+        if (lo == 0) {
+          memory.emplace_after(memory.before_begin(), size_to_bucket,
+                               it_last, it);
+          cosplice(range, left, lhs, it_last);
+        }
+        else {
+          const auto buck_prev = memory.nth(lo - 1);
+          memory.emplace_after(buck_prev, size_to_bucket, it_last, it);
+          cosplice(range, buck_prev->last, lhs, it_last);
+        }
+        __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
+      }
+
+      break;
+    }
+
+    it = it_next;
+  }
+
+  __detail::update_stats(policy, [&memory](auto& stats) {
+    for (const auto& bucket : memory) stats.traversed+= bucket.size;
+    stats.buckets+= memory.size();
+  });
+
+  return false;
+}
+
+/**
+ * @brief  The first phase of the bucket sort: distributes the
+ *         elements of the (non-empty) interval (left, end) into
+ *         consecutive buckets, so that every bucket precedes the ones
+ *         with greater elements. The sizes and the last elements of
+ *         the buckets are stored in memory
+ * @return True iff the last bucket is dirty, i.e., contains elements
+ *         that did not fit into memory.capacity() equivalence classes
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Comp, typename Buckets, typename Policy>
+  requires(!Policy::merge_buckets)
+constexpr bool bucket_sort_distribute
+  (R&& range, const L1 left, const L2 end, const EqRel is_eq, const Comp comp,
+   Buckets& memory, [[maybe_unused]] const Policy& policy) {
+  auto lhs = after(range, left);  // Rightmost bucketed
+
+  /* First, traverse the range to fill the buckets up. Our
+   * flat_ranked_list contains the size of every bucket and an
+   * iterator to its last element.
+   * Invariant: if a bucket with b precedes the one with c in the
+   * range then c >= b */
+
+  // The first element always has its own bucket
+  auto last_buck = memory.emplace_after(memory.before_begin(), size_t{1}, lhs);
+
+  // If the range has more equivalency classes than the capacity, we
+  // will put them in the last bucket and inplace_merge later
+  const size_t max_buckets = memory.capacity();
+  bool last_buck_dirty = false;
+
+  for (auto it = ranges::next(lhs); it != end;) {
+    if constexpr (Policy::prefetch) {
+      const auto it_next = ranges::next(it);
+      if (it_next != end) __detail::prefetch<Policy>(range, it_next);
+    }
+
+    // We deal with the last bucket separately (the comparator is only
+    // called if the element is not in it, unless it is three-way)
+    const auto order =
+      __detail::bucket_order(is_eq, comp, *it, *last_buck->last);
+    if (order == 0) {
+      // No need for splicing, just fast forward
+      ++last_buck->size;
+      last_buck->last = it;
+      lhs = it++;
+      continue;
+    }
+
+    const bool can_add_buckets = memory.size() < max_buckets;
+
+    /* Okay, the element is not in the last bucket, but we might still
+     * get away with no splicing: if the element is greater than the
+     * representative, it cannot be in any bucket preceding this one
+     * because of the invariant and the consistency. Therefore we will
+     * need to start another bucket right here */
+    if (order > 0) {
+      if (can_add_buckets)
+        last_buck = memory.emplace_after(last_buck, size_t{1}, it);
+      else {
+        // Put the unbucketed in the last bucket still (note that the
+        // last bucket cannot change after the maximum is reached)
+        ++last_buck->size;
+        last_buck_dirty = true;
+        __detail::update_stats(policy, [](auto& stats) {
+          ++stats.bucket_overflows;
+        });
+      }
+
+      lhs = it++;
+      continue;
+    }
+
+    // Fine, we need to check other buckets and splice. First decide
+    // how many elements go, so we can optimize the splicing a little
+    size_t size_to_bucket = 1;
+    auto it_last = it;
+    auto it_next = ranges::next(it);
     for (; it_next != end && is_eq(*it, *it_next); it_last = it_next++)
       ++size_to_bucket;
 
-    /* Now iterate the buckets to either find the proper one or the
-     * position to put a new bucket after. Note that if the relation
-     * is totally consistent with the order, then we get here only if
-     * the current element is strictly less than the representative,
-     * so there is no additional work in that case */
+    /* Now binary search the buckets preceding the last one for either
+     * the proper one or the position to put a new bucket at. The
+     * representatives are ordered by x<'y <=> x<y & !(x~y) (see
+     * bucket_sort_splice), so the ones less than *it in that sense
+     * come first. If the relation is only weakly consistent with the
+     * order, there may be several buckets equivalent to *it relative
+     * to the ordering, and it doesn't matter which of them we end up
+     * next to: no stability is guaranteed anyway */
     bool need_new_bucket = true;
-    auto buck_it = memory.before_begin();
-    for (auto buck_it_next = memory.begin(); buck_it_next != last_buck;
-         buck_it = buck_it_next++) {
-      if (is_eq(*it, *buck_it_next->second)) {
+    size_t lo = 0, hi = memory.size() - 1;
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      const auto order =
+        __detail::bucket_order(is_eq, comp, *it, *memory.nth(mid)->last);
+
+      if (order == 0) {
         // Found the proper bucket
         need_new_bucket = false;
-        buck_it = buck_it_next;
+        lo = mid;
         break;
       }
 
-      /* Wrong bucket, same logic: if *it is less than the
-       * representative, new bucket goes before this one.
-       * Note that since the representative of the last bucket is >=
-       * *it, this will always be true for the last bucket in case of
-       * total consistency. Otherwise, and if it isn't, then those
-       * representatives are equivalent (relative to the ordering),
-       * and it doesn't matter whether we put this bucket before or
-       * after the last one: no stability is guaranteed anyway */
-      if (comp(*it, *buck_it_next->second))
-        break;
+      if (order > 0) lo = mid + 1;
+      else hi = mid;
     }
 
     it = it_next;
 
+    auto buck_it = memory.nth(lo);
     if (need_new_bucket) {
       if (!can_add_buckets) {
         // There is too many buckets already: keep the unbucketed
         // elements in the last bucket for now
-        last_buck->first+= size_to_bucket;
+        last_buck->size+= size_to_bucket;
         last_buck_dirty = true;
+        __detail::update_stats(policy, [size_to_bucket](auto& stats) {
+          stats.bucket_overflows+= size_to_bucket;
+        });
 
         lhs = it_last;
         continue;
       }
 
-      if (buck_it == memory.before_begin()) {
+      // The new bucket goes before the last one (at rank lo)
+      ++last_buck;
+
+      if (lo == 0) {
         // Less or equal to all the buckets
-        memory.emplace_after(buck_it, size_to_bucket, it_last);
+        memory.emplace_after(memory.before_begin(), size_to_bucket, it_last);
         cosplice(range, left, lhs, it_last);
+        __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
         continue;
       }
-      buck_it = memory.emplace_after(buck_it, 0, buck_it->second);
+
+      const auto buck_prev = memory.nth(lo - 1);
+      buck_it = memory.emplace_after(buck_prev, size_t{0}, buck_prev->last);
     }
 
-    cosplice(range, buck_it->second, lhs, it_last);
-    buck_it->first+= size_to_bucket;
-    buck_it->second = it_last;
+    cosplice(range, buck_it->last, lhs, it_last);
+    __detail::update_stats(policy, [](auto& stats) { ++stats.splices; });
+    buck_it->size+= size_to_bucket;
+    buck_it->last = it_last;
   }
 
-  /* Phew, that was rough! Now we have these wonderful buckets
-   * perfectly ordered, so we can apply our merge sort to each of
-   * them. After that the range will be sorted */
+  // Every element has been visited exactly once
+  __detail::update_stats(policy, [&memory](auto& stats) {
+    for (const auto& bucket : memory) stats.traversed+= bucket.size;
+    stats.buckets+= memory.size();
+  });
+
+  return last_buck_dirty;
+}
+
+/**
+ * @brief The second phase of the bucket sort: sorts the buckets,
+ *        filled by bucket_sort_distribute(), one after another
+ **/
+template <spliceable_range R, left_limit_of<R> L,
+          typename Comp, typename Buckets, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_buckets
+  (R&& range, const L left, const bool last_buck_dirty, const Comp comp,
+   Buckets& memory, const Policy& policy) {
   auto buck_it = memory.begin();
 
-  size_t size = buck_it->first;
-  auto last = __detail::merge_sort_splice(range, left, buck_it->first, comp);
+  size_t size = buck_it->size;
+  auto last = __detail::merge_sort_splice(range, left, buck_it->size,
+                                          comp, policy);
 
-  if (buck_it != last_buck) [[likely]] {
+  if (++buck_it != memory.end()) [[likely]] {
     // More buckets to come
     ranges::iterator_t<R> prev_last;
     do {
-      ++buck_it;
-      size+= buck_it->first;
+      size+= buck_it->size;
 
       prev_last = last;  // Remember in case the last bucket is dirty
-      last = __detail::merge_sort_splice(range, last, buck_it->first, comp);
+      last = __detail::merge_sort_splice(range, last, buck_it->size,
+                                         comp, policy);
     }
-    while (buck_it != last_buck);
+    while (++buck_it != memory.end());
 
-    if (last_buck_dirty)
+    if (last_buck_dirty) {
+      __detail::update_stats(policy, [](auto& stats) {
+        ++stats.dirty_bucket_merges;
+      });
       last =
-        __detail::coinplace_merge_splice(range, left, prev_last, last, comp);
+        __detail::coinplace_merge_splice(range, left, prev_last, last,
+                                         comp, policy);
+    }
+  }
+
+  return std::make_pair(size, last);
+}
+
+/**
+ * @brief The bucket sort with the buckets ordered by bucket_comp
+ *        (weakly consistent with comp) instead of comp itself, which
+ *        only sorts the elements of the buckets
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename BucketComp, typename Comp,
+          typename Buckets, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (R&& range, const L1 left, const L2 end,
+   const EqRel is_eq, const BucketComp bucket_comp, const Comp comp,
+   Buckets& memory, const Policy& policy) {
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+  // Okay, that was nasty, but now we know the range has something
+
+  const bool last_buck_dirty =
+    __detail::bucket_sort_distribute(range, left, end, is_eq, bucket_comp,
+                                     memory, policy);
+
+  /* Phew, that was rough! Now we have these wonderful buckets
+   * perfectly ordered, so we can apply our merge sort to each of
+   * them. After that the range will be sorted */
+  return __detail::bucket_sort_buckets(range, left, last_buck_dirty, comp,
+                                       memory, policy);
+}
+
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Comp, typename Buckets, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (R&& range, const L1 left, const L2 end, const EqRel is_eq, const Comp comp,
+   Buckets& memory, const Policy& policy) {
+  return __detail::bucket_sort_splice(std::forward<R>(range), left, end,
+                                      is_eq, comp, comp, memory, policy);
+}
+
+template <typename K>
+concept radix_key = std::integral<K> && !std::same_as<K, bool>;
+
+/**
+ * @brief Converts an integral key to the unsigned one with the same
+ *        order (by flipping the sign bit of the signed ones)
+ **/
+template <radix_key K>
+constexpr std::make_unsigned_t<K> radix_unsigned_key(const K key) noexcept {
+  using key_t = std::make_unsigned_t<K>;
+  if constexpr (std::is_signed_v<K>)
+    return key_t(key) ^ (key_t{1} << (std::numeric_limits<key_t>::digits - 1));
+  else
+    return key;
+}
+
+template <typename Proj>
+constexpr auto project_radix_key(Proj& proj) noexcept {
+  return [&proj](auto&& value) {
+    return
+      radix_unsigned_key(std::invoke(proj,
+                                     std::forward<decltype(value)>(value)));
+  };
+}
+
+/**
+ * @brief The buckets indexed directly by a number in [0, _buckets),
+ *        filled by radix_distribute()
+ **/
+template <size_t _buckets, typename R>
+struct indexed_buckets {
+  constexpr static size_t npos = _buckets;
+
+  // The last elements of the buckets
+  std::array<ranges::iterator_t<R>, _buckets> tails;
+  // The bitmask of non-empty buckets
+  std::array<uint64_t, (_buckets + 63) / 64> nonempty;
+
+  constexpr bool has(const size_t bucket) const noexcept {
+    return nonempty[bucket / 64] & (uint64_t{1} << (bucket % 64));
+  }
+
+  constexpr void add(const size_t bucket) noexcept {
+    nonempty[bucket / 64]|= uint64_t{1} << (bucket % 64);
+  }
+
+  // Returns the greatest non-empty bucket less than the given one,
+  // or npos if there is no such bucket
+  constexpr size_t prev(const size_t bucket) const noexcept {
+    size_t word = bucket / 64;
+    uint64_t mask =
+      nonempty[word] & ((uint64_t{1} << (bucket % 64)) - 1);
+    while (!mask) {
+      if (word == 0) return npos;
+      mask = nonempty[--word];
+    }
+    return word * 64 + std::bit_width(mask) - 1;
+  }
+};
+
+template <size_t _radix_bits, typename R>
+struct radix_sort_splice_data:
+    indexed_buckets<size_t{1} << _radix_bits, R> {
+  constexpr static size_t radix = size_t{1} << _radix_bits;
+};
+
+template <typename R, typename Proj>
+using radix_key_t = std::make_unsigned_t
+  <std::remove_cvref_t<std::indirect_result_t<Proj&, ranges::iterator_t<R>>>>;
+
+/**
+ * @brief  Traverses the (non-empty) interval [first, end)
+ * @return Its size, its last element and the bits that differ among
+ *         the keys of its elements
+ **/
+template <typename R, right_limit_of<R> L, typename Key, typename Policy>
+constexpr auto radix_scan
+  (R& range, const ranges::iterator_t<R> first, const L end, const Key key,
+   [[maybe_unused]] const Policy& policy) {
+  using key_t = decltype(key(*first));
+
+  size_t size = 1;
+  auto last = first;
+  key_t or_keys = key(*first), and_keys = or_keys;
+  for (auto it = ranges::next(first); it != end; last = it++, ++size) {
+    if constexpr (Policy::prefetch) {
+      const auto it_next = ranges::next(it);
+      if (it_next != end) __detail::prefetch<Policy>(range, it_next);
+    }
+
+    const key_t cur = key(*it);
+    or_keys|= cur;
+    and_keys&= cur;
+  }
+
+  return std::make_tuple(size, last, key_t(or_keys ^ and_keys));
+}
+
+/**
+ * @brief  Distributes the elements of the (non-empty) interval (left,
+ *         end) into the buckets by their digits, keeping them in the
+ *         range itself: the buckets become consecutive subranges in
+ *         the increasing order of their digits. The last elements of
+ *         the buckets are stored in memory (and their sizes in counts,
+ *         unless it is nullptr_t)
+ * @return The greatest digit of the elements
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename DigitOf, typename Data, typename Counts, typename Policy>
+constexpr size_t radix_distribute
+  (R& range, const L1 left, const L2 end, const DigitOf digit_of,
+   Data& memory,
+   [[maybe_unused]] const Counts counts,
+   [[maybe_unused]] const Policy& policy) {
+  constexpr bool count = !std::is_null_pointer_v<Counts>;
+
+  /* The processed part (left, lhs] always consists of the non-empty
+   * buckets in the increasing order of their digits, so lhs is the
+   * last element of the greatest one (top) */
+  memory.nonempty.fill(0);
+
+  auto lhs = after(range, left);
+  size_t top = digit_of(*lhs);
+  memory.tails[top] = lhs;
+  memory.add(top);
+  if constexpr (count) counts[top] = 1;
+
+  for (auto it = ranges::next(lhs); it != end;) {
+    if constexpr (Policy::prefetch) {
+      const auto it_next = ranges::next(it);
+      if (it_next != end) __detail::prefetch<Policy>(range, it_next);
+    }
+
+    const size_t digit = digit_of(*it);
+    if (digit >= top) {
+      // The element stays where it is, possibly starting a new
+      // bucket
+      if (digit > top) {
+        memory.add(digit);
+        top = digit;
+        if constexpr (count) counts[top] = 0;
+      }
+      memory.tails[top] = lhs = it++;
+      if constexpr (count) ++counts[top];
+      continue;
+    }
+
+    // The element must go to the front, and so do the following
+    // ones with the same digit
+    auto it_last = it;
+    auto it_next = ranges::next(it);
+    [[maybe_unused]] size_t run = 1;
+    for (; it_next != end && digit_of(*it_next) == digit;
+         it_last = it_next++) {
+      if constexpr (count) ++run;
+    }
+
+    if (memory.has(digit)) {
+      cosplice(range, memory.tails[digit], lhs, it_last);
+      if constexpr (count) counts[digit]+= run;
+    }
+    else {
+      memory.add(digit);
+      if (const auto prev = memory.prev(digit); prev == memory.npos)
+        cosplice(range, left, lhs, it_last);
+      else
+        cosplice(range, memory.tails[prev], lhs, it_last);
+      if constexpr (count) counts[digit] = run;
+    }
+
+    memory.tails[digit] = it_last;
+    it = it_next;
+  }
+
+  return top;
+}
+
+template <size_t _radix_bits,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Key, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> radix_sort_splice
+  (R&& range, const L1 left, const L2 end, const Key key,
+   radix_sort_splice_data<_radix_bits, R>& memory, const Policy& policy) {
+  static_assert(_radix_bits > 0 && _radix_bits <= 12);
+  using key_t = decltype(key(*after(range, left)));
+  constexpr size_t key_bits = std::numeric_limits<key_t>::digits;
+  constexpr key_t digit_mask = (key_t{1} << _radix_bits) - 1;
+
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  /* First, find out the size, the last element and which bits of the
+   * keys actually differ: the passes over the constant digits can be
+   * skipped (which is usually the case for the higher ones) */
+  auto [size, last, diff_bits] =
+    __detail::radix_scan(range, first, end, key, policy);
+
+  for (size_t shift = 0; shift < key_bits; shift+= _radix_bits) {
+    if (!((diff_bits >> shift) & digit_mask)) continue;
+
+    const auto digit_of = [&key, shift](const auto& value) {
+      return size_t((key(value) >> shift) & digit_mask);
+    };
+
+    const size_t top =
+      __detail::radix_distribute(range, left, end, digit_of, memory,
+                                 nullptr, policy);
+    last = memory.tails[top];
+  }
+
+  return std::make_pair(size, last);
+}
+
+template <typename F, typename I>
+concept bucket_function = std::indirectly_regular_unary_invocable<F, I>
+  && std::convertible_to<std::indirect_result_t<F&, I>, size_t>;
+
+template <typename BucketOf, typename Proj>
+constexpr auto project_bucket_function(const BucketOf& bucket_of,
+                                       const Proj& proj) noexcept {
+  return [&bucket_of, &proj](const auto& value) {
+    return size_t(std::invoke(bucket_of, std::invoke(proj, value)));
+  };
+}
+
+template <size_t _buckets, typename R>
+struct indexed_bucket_sort_splice_data {
+  indexed_buckets<_buckets, R> buckets;
+  std::array<size_t, _buckets> counts;
+};
+
+/**
+ * @brief The bucket sort with the bucket of every element given by
+ *        bucket_of (a number less than _buckets, non-decreasing along
+ *        comp): the elements are spliced straight to the tails of
+ *        their buckets in a single pass, then every bucket is merge
+ *        sorted
+ **/
+template <size_t _buckets,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename BucketOf, typename Comp, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+indexed_bucket_sort_splice
+  (R&& range, const L1 left, const L2 end,
+   const BucketOf bucket_of, const Comp comp,
+   indexed_bucket_sort_splice_data<_buckets, R>& memory,
+   const Policy& policy) {
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  __detail::radix_distribute(range, left, end, bucket_of, memory.buckets,
+                             memory.counts.data(), policy);
+
+  // The buckets are consecutive, so each one starts right after the
+  // last element of the previous one once that is sorted
+  size_t size = 0;
+  [[maybe_unused]] size_t buckets = 0;
+  ranges::iterator_t<R> last;
+  const auto& nonempty = memory.buckets.nonempty;
+  for (size_t word = 0; word < nonempty.size(); ++word) {
+    for (auto mask = nonempty[word]; mask; mask&= mask - 1) {
+      const size_t bucket = word * 64 + std::countr_zero(mask);
+      const size_t count = memory.counts[bucket];
+
+      if (count == 1)
+        last = memory.buckets.tails[bucket];
+      else if (size == 0)
+        last = __detail::merge_sort_splice(range, left, count, comp, policy);
+      else
+        last = __detail::merge_sort_splice(range, last, count, comp, policy);
+
+      size+= count;
+      if constexpr (Policy::collect_stats) ++buckets;
+    }
   }
 
+  __detail::update_stats(policy, [buckets](auto& stats) {
+    stats.buckets+= buckets;
+  });
+
   return std::make_pair(size, last);
 }
 
+template <typename K>
+concept counting_key = radix_key<K> || std::is_enum_v<K>;
+
+template <typename Proj>
+constexpr auto project_counting_key(Proj& proj) noexcept {
+  return [&proj](auto&& value) {
+    return static_cast<size_t>
+      (std::invoke(proj, std::forward<decltype(value)>(value)));
+  };
+}
+
+/**
+ * @brief The counting sort: the buckets of radix_distribute() are
+ *        indexed by the keys themselves, so a single distribution
+ *        pass leaves the interval sorted
+ **/
+template <size_t _domain,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Key, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+counting_sort_splice
+  (R&& range, const L1 left, const L2 end, const Key key,
+   indexed_bucket_sort_splice_data<_domain, R>& memory,
+   const Policy& policy) {
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  const size_t top =
+    __detail::radix_distribute(range, left, end, key, memory.buckets,
+                               memory.counts.data(), policy);
+
+  size_t size = 0;
+  const auto& nonempty = memory.buckets.nonempty;
+  for (size_t word = 0; word < nonempty.size(); ++word) {
+    for (auto mask = nonempty[word]; mask; mask&= mask - 1)
+      size+= memory.counts[word * 64 + std::countr_zero(mask)];
+  }
+
+  return std::make_pair(size, memory.buckets.tails[top]);
+}
+
+template <size_t _radix_bits, typename R, typename Key>
+struct msd_radix_sort_splice_data {
+  constexpr static size_t radix = size_t{1} << _radix_bits;
+  constexpr static size_t levels =
+    (std::numeric_limits<Key>::digits + _radix_bits - 1) / _radix_bits;
+
+  radix_sort_splice_data<_radix_bits, R> digits;
+  std::array<size_t, radix> counts;
+
+  // The sizes and the last elements of the non-empty buckets of the
+  // interval being distributed on each level of the recursion
+  std::array<bucket_sort_splice_data<radix, R>, levels> buckets;
+};
+
+/**
+ * @brief  Sorts the interval (left, end) of the given size with the
+ *         given last element, the keys of which only differ in the
+ *         lowest (bits) bits, and returns its last element after
+ *         sorting
+ **/
+template <size_t _radix_bits,
+          typename R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename K, typename Key, typename Data, typename Policy>
+constexpr ranges::iterator_t<R> msd_radix_sort_bucket
+  (R& range, const L1 left, const L2 end,
+   const size_t size, const ranges::iterator_t<R> last,
+   size_t bits, const K diff_bits, const Key key,
+   Data& memory, const size_t level, const Policy& policy) {
+  constexpr size_t InsertionThreshold = 8; // Sort the smaller buckets
+  constexpr size_t MergeThreshold = 32;    // with comparisons
+
+  const auto comp = [&key](const auto& lhs, const auto& rhs) {
+    return key(lhs) < key(rhs);
+  };
+
+  for (;;) {
+    if (size <= MergeThreshold) {
+      if (size <= InsertionThreshold)
+        return __detail::insertion_sort_splice(range, left, size,
+                                               comp, policy);
+      return __detail::merge_sort_splice(range, left, size, comp, policy);
+    }
+
+    // Skip the digits that are constant for all the keys
+    size_t shift, digit_mask;
+    do {
+      if (bits == 0) return last; // All the keys are equal
+      shift = bits > _radix_bits ? bits - _radix_bits : 0;
+      digit_mask = (size_t{1} << (bits - shift)) - 1;
+      bits = shift;
+    } while (!(size_t(diff_bits >> shift) & digit_mask));
+
+    const auto digit_of = [&key, shift, digit_mask](const auto& value) {
+      return size_t(key(value) >> shift) & digit_mask;
+    };
+
+    __detail::radix_distribute(range, left, end, digit_of, memory.digits,
+                               memory.counts.data(), policy);
+
+    // Collect the non-empty buckets in order, so that the digit data
+    // can be reused by the next level
+    auto& buckets = memory.buckets[level];
+    buckets.clear();
+
+    auto back = buckets.before_begin();
+    for (size_t word = 0; word < memory.digits.nonempty.size(); ++word) {
+      for (auto mask = memory.digits.nonempty[word]; mask; mask&= mask - 1) {
+        const size_t digit = word * 64 + std::countr_zero(mask);
+        back = buckets.emplace_after(back, memory.counts[digit],
+                                     memory.digits.tails[digit]);
+      }
+    }
+
+    // A single bucket means the digit is constant in this interval,
+    // just proceed to the next one
+    if (buckets.size() == 1) continue;
+
+    // The first bucket is the only one that follows the original
+    // left limit
+    auto buck = buckets.begin();
+    auto buck_left =
+      __detail::msd_radix_sort_bucket<_radix_bits>
+        (range, left, ranges::next(buck->last), buck->size, buck->last,
+         bits, diff_bits, key, memory, level + 1, policy);
+
+    for (++buck; buck != buckets.end(); ++buck) {
+      const auto [buck_size, buck_last] = *buck;
+      buck_left = buck_size == 1 ? buck_last
+        : __detail::msd_radix_sort_bucket<_radix_bits>
+            (range, buck_left, ranges::next(buck_last), buck_size, buck_last,
+             bits, diff_bits, key, memory, level + 1, policy);
+    }
+
+    return buck_left;
+  }
+}
+
+template <size_t _radix_bits,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Key, typename Data, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+msd_radix_sort_splice
+  (R&& range, const L1 left, const L2 end, const Key key,
+   Data& memory, const Policy& policy) {
+  static_assert(_radix_bits > 0 && _radix_bits <= 8);
+  using key_t = decltype(key(*after(range, left)));
+
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  const auto [size, last, diff_bits] =
+    __detail::radix_scan(range, first, end, key, policy);
+
+  return std::make_pair(size,
+                        __detail::msd_radix_sort_bucket<_radix_bits>
+                          (range, left, end, size, last,
+                           std::numeric_limits<key_t>::digits, diff_bits,
+                           key, memory, 0, policy));
+}
+
+/**
+ * @brief Whether the keys of the given type are cached by value by the
+ *        buffered sort (rather than by address), which is the case it
+ *        is fast for
+ **/
+template <typename K>
+concept cheap_sort_key = std::is_trivially_copyable_v<std::remove_cvref_t<K>>
+  && sizeof(std::remove_cvref_t<K>) <= 2*sizeof(void*);
+
+template <typename R, typename Proj>
+using sort_key_t = std::indirect_result_t<Proj&, ranges::iterator_t<R>>;
+
+template <typename K>
+using buffered_key_t =
+  std::conditional_t<!cheap_sort_key<K> && std::is_lvalue_reference_v<K>,
+                     const std::remove_reference_t<K>*,
+                     std::remove_cvref_t<K>>;
+
+template <typename K>
+concept bufferable_sort_key = std::is_lvalue_reference_v<K>
+  || std::movable<std::remove_cvref_t<K>>;
+
+template <typename Key>
+struct buffered_sort_entry {
+  Key key;
+  size_t idx;  // The position of the element in the original order
+
+  constexpr const auto& get_key() const noexcept {
+    if constexpr (std::is_pointer_v<Key>) return *key;
+    else return key;
+  }
+};
+
+/**
+ * @brief  Relinks the nodes iters[idx] in the order of the idx fields
+ *         of the given (non-empty) range of entries right after left,
+ *         assuming they initially follow left in the order of iters
+ * @return The last element of the relinked interval
+ **/
+template <spliceable_range R, left_limit_of<R> L, typename Iters,
+          typename Entries, typename Allocator, typename Policy>
+constexpr ranges::iterator_t<R> relink_splice
+  (R& range, const L left, const Iters& iters, Entries&& entries,
+   Allocator& alloc, [[maybe_unused]] const Policy& policy) {
+  constexpr size_t PrefetchDistance = 8;
+  const size_t size = iters.size();
+
+  /* The sorted part (left, tail] is always followed by the rest of the
+   * elements in their original order, so every element is spliced
+   * from there right after the tail. For the forward ranges, we have
+   * to keep track of the predecessors of the remaining elements in a
+   * separate (index based) doubly-linked list */
+  constexpr bool forward = !ranges::bidirectional_range<R>;
+  constexpr size_t npos = size_t(-1);
+
+  std::conditional_t<forward,
+                     rebound_vector<std::pair<size_t, size_t>, Allocator>,
+                     std::tuple<>> links;
+  if constexpr (forward) {
+    links = decltype(links)(size, alloc);
+    for (size_t i = 0; i < size; ++i)
+      links[i] = { i - 1, i + 1 == size ? npos : i + 1 };
+  }
+
+  const auto move_after = [&](const auto tail, const size_t idx) {
+    const auto it = iters[idx];
+    if constexpr (forward) {
+      const auto [prev, next] = links[idx];
+      if (prev != npos) {
+        cosplice(range, tail, iters[prev], it);
+        links[prev].second = next;
+      }
+      if (next != npos) links[next].first = prev;
+    }
+    else {
+      if (after(range, tail) != it)
+        cosplice(range, tail, ranges::prev(it), it);
+    }
+    return it;
+  };
+
+  auto entry = ranges::begin(entries);
+  const auto entries_end = ranges::end(entries);
+  [[maybe_unused]] auto ahead = entry;
+  if constexpr (Policy::prefetch)
+    ahead = ranges::next(entry, PrefetchDistance + 1, entries_end);
+
+  auto tail = move_after(left, entry->idx);
+  for (++entry; entry != entries_end; ++entry) {
+    if constexpr (Policy::prefetch) {
+      if (ahead != entries_end)
+        __detail::prefetch<Policy>(range, iters[(ahead++)->idx]);
+    }
+
+    tail = move_after(tail, entry->idx);
+  }
+
+  return tail;
+}
+
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Allocator, typename Comp, typename Proj, typename Policy>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+buffered_sort_splice
+  (R&& range, const L1 left, const L2 end, Allocator& alloc,
+   const Comp comp, const Proj proj, [[maybe_unused]] const Policy& policy) {
+  using iterator = ranges::iterator_t<R>;
+  using key_t = buffered_key_t<sort_key_t<R, Proj>>;
+  using entry_t = buffered_sort_entry<key_t>;
+
+  const auto first = after(range, left);
+  if (first == end) return std::make_pair(0, first);
+
+  /* Gather the keys and the iterators into the contiguous buffers in
+   * one traversal. The original positions make the (otherwise
+   * unstable) sort of the keys stable, and also tell where the
+   * iterators are */
+  rebound_vector<entry_t, Allocator> entries(alloc);
+  rebound_vector<iterator, Allocator> iters(alloc);
+
+  for (auto it = first; it != end; ++it) {
+    if constexpr (Policy::prefetch) {
+      const auto it_next = ranges::next(it);
+      if (it_next != end) __detail::prefetch<Policy>(range, it_next);
+    }
+
+    if constexpr (std::is_pointer_v<key_t>)
+      entries.push_back({ std::addressof(std::invoke(proj, *it)),
+                         iters.size() });
+    else
+      entries.push_back({ std::invoke(proj, *it), iters.size() });
+    iters.push_back(it);
+  }
+
+  const size_t size = iters.size();
+  std::sort(entries.begin(), entries.end(),
+            [&comp](const entry_t& lhs, const entry_t& rhs) {
+    if (std::invoke(comp, lhs.get_key(), rhs.get_key())) return true;
+    return lhs.idx < rhs.idx
+      && !std::invoke(comp, rhs.get_key(), lhs.get_key());
+  });
+
+  // Now relink the nodes in one pass
+  return std::make_pair(size, __detail::relink_splice(range, left, iters,
+                                                      entries, alloc,
+                                                      policy));
+}
+
+/**
+ * @brief The proxy of an element sorted instead of it by the key
+ *        caching sort: its keys (see buffered_key_t) and its position
+ *        in the original order
+ **/
+template <typename... Keys>
+struct cached_sort_entry {
+  using keys_t = std::tuple<Keys...>;
+
+  keys_t keys;
+  size_t idx;
+
+  template <size_t _i>
+  constexpr const auto& get_key() const noexcept {
+    if constexpr (std::is_pointer_v<std::tuple_element_t<_i, keys_t>>)
+      return *std::get<_i>(keys);
+    else
+      return std::get<_i>(keys);
+  }
+};
+
+/**
+ * @brief The projection of a cached_sort_entry to its _i-th key
+ **/
+template <size_t _i>
+struct cached_key_of {
+  constexpr const auto& operator()(const auto& entry) const noexcept {
+    return entry.template get_key<_i>();
+  }
+};
+
+template <typename K, typename Proj, typename T>
+constexpr K cache_sort_key(const Proj& proj, T&& value) {
+  if constexpr (std::is_pointer_v<K>)
+    return std::addressof(std::invoke(proj, std::forward<T>(value)));
+  else
+    return std::invoke(proj, std::forward<T>(value));
+}
+
+/**
+ * @brief  Sorts at most count first elements of the interval (left,
+ *         end) by computing their keys with every one of the
+ *         projections only once: the keys are cached in a spliceable
+ *         list of proxies, which is sorted with sort(proxies,
+ *         cached_key_of<i>{}...), and the nodes of the range are then
+ *         relinked in the resulting order
+ * @return The size of the sorted interval and its last element
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Allocator, typename Sort, typename Policy,
+          typename... Projs>
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+cached_key_sort_splice
+  (R&& range, const L1 left, const L2 end, const size_t count,
+   Allocator& alloc, const Sort& sort, const Policy& policy,
+   const Projs&... projs) {
+  using iterator = ranges::iterator_t<R>;
+  using entry_t = cached_sort_entry<buffered_key_t<sort_key_t<R, Projs>>...>;
+
+  const auto first = after(range, left);
+  if (first == end || count == 0) return std::make_pair(0, first);
+
+  linked_vector<entry_t, std::remove_cvref_t<Allocator>> entries(alloc);
+  rebound_vector<iterator, Allocator> iters(alloc);
+  if (count != size_t(-1)) {
+    // The size is known (i.e., the interval is a corange)
+    entries.reserve(count);
+    iters.reserve(count);
+  }
+
+  auto back = entries.before_begin();
+  for (auto it = first; it != end && iters.size() < count; ++it) {
+    if constexpr (Policy::prefetch) {
+      const auto it_next = ranges::next(it);
+      if (it_next != end) __detail::prefetch<Policy>(range, it_next);
+    }
+
+    back = entries.emplace_after
+      (back, typename entry_t::keys_t{
+          __detail::cache_sort_key<buffered_key_t<sort_key_t<R, Projs>>>
+            (projs, *it)...
+        }, iters.size());
+    iters.push_back(it);
+  }
+
+  [&sort, &entries]<size_t... _is>(std::index_sequence<_is...>) {
+    sort(entries, cached_key_of<_is>{}...);
+  }(std::index_sequence_for<Projs...>{});
+
+  return std::make_pair(iters.size(),
+                        __detail::relink_splice(range, left, iters, entries,
+                                                alloc, policy));
+}
+
+/**
+ * @brief  Calls sort(range, left, end, projs...), or, if the policy
+ *         caches the keys (see Policy::cache_keys), the same for the
+ *         proxies of (at most count first) elements of the interval
+ *         (left, end) with their cached keys and the projections to
+ *         them (see cached_key_sort_splice)
+ * @return The size of the sorted interval and its last element (sort
+ *         must return the same)
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Allocator, typename Sort, typename Policy,
+          typename... Projs>
+constexpr std::pair<size_t, ranges::iterator_t<R>> sort_with_keys
+  (R& range, const L1 left, const L2 end, const size_t count,
+   Allocator& alloc, const Sort& sort, const Policy& policy,
+   const Projs&... projs) {
+  if constexpr (!Policy::cache_keys)
+    return sort(range, left, end, projs...);
+  else
+    return __detail::cached_key_sort_splice
+      (range, left, end, count, alloc,
+       [&sort](auto& entries, const auto... keys_of) {
+         sort(entries, entries.before_begin(), entries.end(), keys_of...);
+       }, policy, projs...);
+}
+
 } // namespace enranged::__detail
@@ -0,0 +1,276 @@
+#pragma once
+#include <concepts>
+#include <forward_list>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+#include "sorting.hpp"
+
+#include "__detail/parallel_sorting_impl.hpp"
+
+/**
+ * @file
+ * Parallel versions of the splice-based sorting algorithms
+ *
+ * @note  With libstdc++, including <execution> (which this header
+ *        does, if available) may require linking against TBB
+ *
+ * @author    patternnoster@github
+ * @copyright 2023, under the MIT License (see /LICENSE for details)
+ **/
+
+namespace enranged {
+
+/**
+ * @brief A customization point telling whether the elements of
+ *        disjoint subranges of a range of type R can be spliced
+ *        concurrently, as long as those subranges are separated by at
+ *        least one element that is not moved. Disabled by default
+ *
+ * For example, it is enabled for std::forward_list (splicing only
+ * modifies the nodes themselves), but not for std::list, since
+ * std::list<T>::splice() updates the size of the list, even when the
+ * source and destination lists are the same
+ **/
+template <typename R>
+constexpr bool enable_concurrent_splicing = false;
+
+template <typename T, typename Allocator>
+constexpr bool enable_concurrent_splicing<std::forward_list<T, Allocator>> =
+  true;
+
+/**
+ * @brief The concept of a spliceable range, disjoint subranges of
+ *        which can be spliced concurrently (see
+ *        enable_concurrent_splicing)
+ **/
+template <typename R>
+concept concurrently_spliceable_range = spliceable_range<R>
+  && enable_concurrent_splicing<std::remove_cvref_t<R>>;
+
+/**
+ * @brief The concept of an executor, that can be passed to the parallel
+ *        sorting algorithms to run their tasks
+ *
+ * The method execute() must run the given task (at some point)
+ * independently of the calling thread, and the method
+ * max_concurrency() must return the number of the tasks that the
+ * executor is (usually) capable of running simultaneously. Note that
+ * the algorithms block the calling thread until all of their tasks are
+ * finished
+ **/
+template <typename E>
+concept sort_executor = requires(E& executor, std::function<void()> task) {
+  executor.execute(std::move(task));
+  { executor.max_concurrency() } -> std::convertible_to<size_t>;
+};
+
+/**
+ * @brief  Performs a parallel splice-based version of the stable merge
+ *         sorting algorithm on the corange (left, left + count] and
+ *         returns an iterator to its last element
+ *
+ * The corange is cut into max_concurrency() parts, separated by
+ * single elements, which are sorted with the executor
+ * simultaneously. The parts and the separators are then merged
+ * pairwise in (log(max_concurrency()) rounds of) parallel tasks
+ *
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  count must not be greater than the number of elements
+ *         following left in the given range
+ * @return An iterator to the last element of the sorted corange (or
+ *         after(range, left) if count is zero)
+ * @note   If an exception is thrown by the comparator, it is rethrown
+ *         once all the tasks are finished
+ **/
+template <sort_executor Executor,
+          concurrently_spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+ranges::borrowed_iterator_t<R> merge_sort_splice
+  (Executor&& executor, R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  return merge_sort_splice(default_sort_policy{}, executor,
+                           std::forward<R>(range), left, count, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, sort_executor Executor,
+          concurrently_spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+ranges::borrowed_iterator_t<R> merge_sort_splice
+  (const Policy& policy, Executor&& executor,
+   R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  return
+    __detail::parallel_merge_sort_splice(executor, std::forward<R>(range),
+                                         left, count,
+                                         __detail::project_predicate(comp,
+                                                                     proj),
+                                         policy);
+}
+
+/**
+ * @brief  Performs a parallel splice-based version of the bucket
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range (see bucket_sort_splice for the requirements)
+ *
+ * The distribution of the elements into the buckets is sequential,
+ * the buckets are then split into max_concurrency() groups of roughly
+ * the same size, sorted with the executor simultaneously
+ *
+ * @tparam _max_buckets is the maximum number of equivalence classes
+ *         used for the given interval
+ * @tparam EqRel must be an equivalence relation weakly consistent
+ *         with Comp (see bucket_sort_splice)
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   If an exception is thrown by the comparator, it is rethrown
+ *         once all the tasks are finished
+ **/
+template <size_t _max_buckets = 32, sort_executor Executor,
+          concurrently_spliceable_range R,
+          left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (Executor&& executor, R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice<_max_buckets>(default_sort_policy{}, executor,
+                                          std::forward<R>(range), left, right,
+                                          rel, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _max_buckets = 32, sort_policy Policy,
+          sort_executor Executor, concurrently_spliceable_range R,
+          left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, Executor&& executor,
+   R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  __detail::bucket_sort_splice_data<_max_buckets, R, Policy::merge_buckets>
+    data;
+  return
+    __detail::parallel_bucket_sort_splice(executor, std::forward<R>(range),
+                                          left, right,
+                                          __detail::project_predicate(rel,
+                                                                      proj1),
+                                          __detail::project_predicate(comp,
+                                                                      proj2),
+                                          data, policy);
+}
+
+#if __cpp_lib_execution
+
+/**
+ * @brief  Performs a splice-based version of the stable merge sorting
+ *         algorithm on the corange (left, left + count] with the given
+ *         standard execution policy and returns an iterator to its
+ *         last element. The parallel policies run the tasks in new
+ *         threads, one per hardware thread (see above for details)
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  count must not be greater than the number of elements
+ *         following left in the given range
+ * @return An iterator to the last element of the sorted corange (or
+ *         after(range, left) if count is zero)
+ **/
+template <typename ExecutionPolicy,
+          concurrently_spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+           && splice_sortable_range<R, Comp, Proj>)
+ranges::borrowed_iterator_t<R> merge_sort_splice
+  (ExecutionPolicy&&, R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  using policy_t = std::remove_cvref_t<ExecutionPolicy>;
+  if constexpr (std::same_as<policy_t, std::execution::sequenced_policy>
+                || std::same_as<policy_t,
+                                std::execution::unsequenced_policy>)
+    return merge_sort_splice(std::forward<R>(range), left, count, comp, proj);
+  else
+    return merge_sort_splice(__detail::thread_executor{},
+                             std::forward<R>(range), left, count, comp, proj);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the open interval (left, right) in the given
+ *         range with the given standard execution policy. The parallel
+ *         policies run the tasks in new threads, one per hardware
+ *         thread (see above for details)
+ * @tparam _max_buckets is the maximum number of equivalence classes
+ *         used for the given interval
+ * @tparam EqRel must be an equivalence relation weakly consistent
+ *         with Comp (see bucket_sort_splice)
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ **/
+template <size_t _max_buckets = 32, typename ExecutionPolicy,
+          concurrently_spliceable_range R,
+          left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+           && _max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (ExecutionPolicy&&, R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  using policy_t = std::remove_cvref_t<ExecutionPolicy>;
+  if constexpr (std::same_as<policy_t, std::execution::sequenced_policy>
+                || std::same_as<policy_t,
+                                std::execution::unsequenced_policy>)
+    return bucket_sort_splice<_max_buckets>(std::forward<R>(range),
+                                            left, right,
+                                            rel, proj1, comp, proj2);
+  else
+    return bucket_sort_splice<_max_buckets>(__detail::thread_executor{},
+                                            std::forward<R>(range),
+                                            left, right,
+                                            rel, proj1, comp, proj2);
+}
+
+#endif
+
+} // namespace enranged
@@ -1,8 +1,14 @@
 #pragma once
+#include <algorithm>
+#include <bit>
+#include <compare>
 #include <concepts>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <ranges>
+#include <type_traits>
+#include <vector>
 
 #include "splicing.hpp"
 
@@ -50,6 +56,311 @@ concept splice_sortable_range = spliceable_range<R>
                                      std::projected<ranges::iterator_t<R>,
                                                     Proj>>;
 
+/**
+ * @brief The concept of a range that can be sorted by splicing with
+ *        the provided three-way comparator, i.e., one returning values
+ *        convertible to std::weak_ordering (e.g., with operator<=>),
+ *        such that cmp(x, y) < 0 is a strict weak order (see above)
+ **/
+template <typename R,
+          typename Cmp = std::compare_three_way,
+          typename Proj = std::identity>
+concept three_way_sortable_range =
+  splice_sortable_range<R, __detail::three_way_less<Cmp>, Proj>;
+
+/**
+ * @brief The policy used by the sorting algorithms by default. Custom
+ *        policies must be derived from it (see sort_policy)
+ **/
+struct default_sort_policy {
+  /**
+   * @brief Whether the algorithms should issue software prefetches
+   *        for the nodes they are about to access
+   **/
+  constexpr static bool prefetch = false;
+
+  /**
+   * @brief The minimal number of elements per thread for the parallel
+   *        versions of the algorithms (see parallel_sorting.hpp): the
+   *        smaller subranges are not worth the synchronization
+   **/
+  constexpr static size_t parallel_min_chunk = 8192;
+
+  /**
+   * @brief The minimal number of elements for which the buffered sort
+   *        is preferred over the in-place algorithms (see
+   *        prefers_buffered_sort)
+   **/
+  constexpr static size_t buffered_sort_min_size = 4096;
+
+  /**
+   * @brief The number of consecutive elements the in-place merges
+   *        take from one side before they switch to galloping (see
+   *        galloping_sort_policy). Zero disables galloping
+   **/
+  constexpr static size_t min_gallop = 0;
+
+  /**
+   * @brief The size of the runs the merge sorts start from, sorted
+   *        with a sorting network (see network_sort_policy). Zero
+   *        means the runs of 4 elements sorted with insertions
+   **/
+  constexpr static size_t network_leaf_size = 0;
+
+  /**
+   * @brief Whether the bucket sort should merge the sparse buckets
+   *        once it runs out of them, instead of collecting the rest of
+   *        the elements in the last one (see merging_bucket_sort_policy)
+   **/
+  constexpr static bool merge_buckets = false;
+
+  /**
+   * @brief Whether merge_sort_splice and bucket_sort_splice should
+   *        compute the projections once per element and sort the
+   *        cached keys (see key_caching_sort_policy)
+   **/
+  constexpr static bool cache_keys = false;
+
+  /**
+   * @brief Whether the algorithms should collect the sort statistics
+   *        (see stats_sort_policy)
+   **/
+  constexpr static bool collect_stats = false;
+};
+
+/**
+ * @brief The concept of a sort policy, that can be passed as the first
+ *        argument to the sorting algorithms to tune their behaviour
+ *
+ * A sort policy must be derived (directly or not) from
+ * default_sort_policy, so that it only needs to override the static
+ * members it is interested in
+ **/
+template <typename P>
+concept sort_policy = std::derived_from<P, default_sort_policy>;
+
+/**
+ * @brief A sort policy that enables software prefetching of the nodes
+ *        following the current position(s) of the algorithm
+ *
+ * Splicing-based algorithms are, in essence, pointer chasing: when
+ * the nodes of a list are scattered in memory, every step forward is
+ * a likely cache miss. With this policy, the algorithms request the
+ * next node on one side (e.g., of the merge) before they start
+ * scanning the other one, hiding some of the latency. If the range
+ * has a method prefetch(it) declared noexcept, it is called for the
+ * nodes instead (e.g., to prefetch the node itself and not just the
+ * element it holds), otherwise the address of *it is used
+ *
+ * @tparam Base the policy to inherit the rest of the members from
+ * @note   Prefetching only pays off for lists with poor locality and
+ *         can make things slightly worse for the compact ones (and
+ *         for the merge sort of std::forward_list in the benchmarks)
+ **/
+template <sort_policy Base = default_sort_policy>
+struct prefetching_sort_policy: Base {
+  constexpr static bool prefetch = true;
+};
+
+/**
+ * @brief A sort policy that enables galloping in the in-place merges
+ *        (coinplace_merge_splice and the merge sorts built on it)
+ *
+ * As in TimSort, once _min_gallop consecutive elements are taken from
+ * one side of a merge, the rest of the run is found by exponential
+ * probing and bisection, so that a run of n elements costs O(log n)
+ * comparisons instead of O(n). Splicing doesn't let us jump, so the
+ * probes are still reached by walking from the last checked element,
+ * and the number of steps stays the same
+ *
+ * @tparam Base the policy to inherit the rest of the members from
+ * @note   Galloping only pays off when the comparisons cost more than
+ *         the steps (e.g., for string or tuple keys) and the data has
+ *         long runs, and costs a few extra comparisons otherwise
+ **/
+template <sort_policy Base = default_sort_policy, size_t _min_gallop = 7>
+  requires(_min_gallop > 0)
+struct galloping_sort_policy: Base {
+  constexpr static size_t min_gallop = _min_gallop;
+};
+
+/**
+ * @brief A sort policy that makes merge_sort_splice start from the
+ *        runs of _leaf_size elements sorted with a sorting network
+ *
+ * By default, the merge sorts start from the runs of 4 elements
+ * sorted with insertions, i.e., with comparisons the branches depend
+ * on and a splice per misplaced element. With this policy, the
+ * iterators to the elements of a run are loaded into an array and
+ * sorted by Batcher's odd-even merge network, with no branches
+ * depending on the comparisons (the ties are broken by the original
+ * positions, so the sorting stays stable), and then the nodes are
+ * relinked, with the runs of elements that end up adjacent moved at
+ * once. The bucket sort, sorting its buckets with the merge sort,
+ * benefits as well
+ *
+ * @tparam Base the policy to inherit the rest of the members from
+ * @tparam _leaf_size the size of the runs (a power of 2): the bigger
+ *         ones save more merging, but the networks for them make more
+ *         comparisons than the merges would, so the best size depends
+ *         on the cost of the comparisons (e.g., 8 or 16 for integral
+ *         keys and 4 for strings)
+ **/
+template <sort_policy Base = default_sort_policy, size_t _leaf_size = 8>
+  requires(_leaf_size >= 2 && _leaf_size <= 32
+           && std::has_single_bit(_leaf_size))
+struct network_sort_policy: Base {
+  constexpr static size_t network_leaf_size = _leaf_size;
+};
+
+/**
+ * @brief A sort policy that makes bucket_sort_splice merge the
+ *        adjacent sparse buckets when it runs out of them
+ *
+ * By default, once all the buckets are taken, the elements of every
+ * new equivalence class go to the last bucket, which is then sorted
+ * and merged with the rest as a whole. So, if the number of classes
+ * exceeds the number of buckets (e.g., the data has a long tail of
+ * rare keys), the tail is sorted with the merge sort. With this
+ * policy, the runs of adjacent buckets holding few elements are merged
+ * instead, freeing room for the new classes. A merged bucket takes
+ * every element between its first one and the next bucket, but is
+ * still sorted on its own, so the dense classes keep their buckets and
+ * the algorithm slides towards the merge sort only as much as the data
+ * requires
+ *
+ * @tparam Base the policy to inherit the rest of the members from
+ * @note   The buckets are looked up by their first elements, which
+ *         are in different nodes than the last ones (touched anyway),
+ *         so the merging only pays off when the buckets do run out
+ **/
+template <sort_policy Base = default_sort_policy>
+struct merging_bucket_sort_policy: Base {
+  constexpr static bool merge_buckets = true;
+};
+
+/**
+ * @brief A sort policy that makes merge_sort_splice and
+ *        bucket_sort_splice compute the projections once per element
+ *
+ * The algorithms call the projections on every comparison, i.e.,
+ * O(n log n) times, which dominates the cost of the sort if they are
+ * expensive (e.g., parse or format the elements, or chase pointers to
+ * other objects). With this policy, the projected keys are first
+ * collected (along with the positions of the elements) into a
+ * contiguous side list, which is sorted by the same algorithm,
+ * comparing the cached keys only, and then the nodes of the range are
+ * relinked in the resulting order in one pass. The keys returned by
+ * reference are cached by address, unless they are cheap to copy (see
+ * buffered_sort_splice)
+ *
+ * @tparam Base the policy to inherit the rest of the members from
+ * @note   The side list takes O(n) extra memory (from the given
+ *         allocator, or from std::allocator in the overloads taking
+ *         none), so caching only pays off when the projections cost
+ *         more than a few memory accesses. The parallel algorithms
+ *         don't support this policy
+ **/
+template <sort_policy Base = default_sort_policy>
+struct key_caching_sort_policy: Base {
+  constexpr static bool cache_keys = true;
+};
+
+/**
+ * @brief The statistics collected by the sorting algorithms run with
+ *        a stats_sort_policy. The counters are only ever increased,
+ *        so the same object can accumulate several runs
+ **/
+struct sort_stats {
+  /**
+   * @brief The number of calls of the comparator (and of the
+   *        equivalence relation, for the bucket sort)
+   **/
+  size_t comparisons = 0;
+
+  /**
+   * @brief The number of cosplice() calls
+   **/
+  size_t splices = 0;
+
+  /**
+   * @brief The number of steps made from an element to the next one
+   *        while scanning the range
+   **/
+  size_t traversed = 0;
+
+  /**
+   * @brief The number of sorted runs the merge sorts start merging
+   *        from: the runs found by natural_merge_sort_splice or the
+   *        small ones sorted with insertions by merge_sort_splice
+   **/
+  size_t runs = 0;
+
+  /**
+   * @brief The maximum recursion depth of merge_sort_splice on a
+   *        corange, or the maximum number of runs on the stack of the
+   *        merge sorts of open intervals
+   **/
+  size_t max_depth = 0;
+
+  /**
+   * @brief The current recursion depth (zero outside the algorithms)
+   **/
+  size_t depth = 0;
+
+  /**
+   * @brief The number of buckets filled by bucket_sort_splice
+   **/
+  size_t buckets = 0;
+
+  /**
+   * @brief The number of elements that did not fit into _max_buckets
+   *        equivalence classes and were put into the last bucket
+   **/
+  size_t bucket_overflows = 0;
+
+  /**
+   * @brief The number of times the last bucket was dirty, i.e., had
+   *        to be merged with the rest of the elements after sorting
+   **/
+  size_t dirty_bucket_merges = 0;
+
+  /**
+   * @brief The number of buckets merged into their neighbours to make
+   *        room for new equivalence classes (see
+   *        merging_bucket_sort_policy)
+   **/
+  size_t bucket_merges = 0;
+};
+
+/**
+ * @brief A sort policy that makes the algorithms record what they do
+ *        in the given sort_stats object
+ *
+ * The statistics are collected by coinplace_merge_splice,
+ * insertion_sort_splice, merge_sort_splice,
+ * natural_merge_sort_splice and bucket_sort_splice. The comparisons
+ * are also counted by merge_splice, partial_sort_splice,
+ * nth_element_splice and quick_sort_splice. The other algorithms
+ * accept the policy too, but only account for the parts of their work
+ * done with the ones listed above. With any other policy, the
+ * bookkeeping compiles to nothing
+ *
+ * @tparam Base the policy to inherit the rest of the members from
+ * @note   The counters are not synchronized, so the policy cannot be
+ *         used with the parallel algorithms, or with the same object
+ *         in several threads
+ **/
+template <sort_policy Base = default_sort_policy>
+struct stats_sort_policy: Base {
+  constexpr static bool collect_stats = true;
+
+  constexpr explicit stats_sort_policy(sort_stats& stats) noexcept:
+    stats(std::addressof(stats)) {}
+
+  sort_stats* stats;
+};
+
 /**
  * @brief  Given a subrange (left, right] of a spliceable range and an
  *         iterator mid from that subrange, assumes the subranges
@@ -82,9 +393,25 @@ constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
   (R&& range, const L left,
    const ranges::iterator_t<R> mid, const ranges::iterator_t<R> right,
    const Comp comp = {}, const Proj proj = {}) {
+  return coinplace_merge_splice(default_sort_policy{}, std::forward<R>(range),
+                                left, mid, right, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
+  (const Policy& policy, R&& range, const L left,
+   const ranges::iterator_t<R> mid, const ranges::iterator_t<R> right,
+   const Comp comp = {}, const Proj proj = {}) {
   return
     __detail::coinplace_merge_splice(std::forward<R>(range), left, mid, right,
-                                     __detail::project_predicate(comp, proj));
+                                     __detail::project_predicate(comp, proj,
+                                                                 policy),
+                                     policy);
 }
 
 /**
@@ -110,6 +437,462 @@ constexpr ranges::borrowed_iterator_t<R> coinplace_merge_splice
                            last(range), comp, proj);
 }
 
+/**
+ * @brief The concept of a range of sorted ranges that can be merged
+ *        into a range of type D by splicing with the provided strict
+ *        weak order (see merge_splice)
+ **/
+template <typename Srcs, typename D,
+          typename Comp = ranges::less, typename Proj = std::identity>
+concept merge_spliceable_ranges = ranges::input_range<Srcs>
+  && std::is_lvalue_reference_v<ranges::range_reference_t<Srcs>>
+  && ranges::forward_range<ranges::range_reference_t<Srcs>>
+  && spliceable_with_range<D, ranges::range_reference_t<Srcs>>
+  && std::same_as<ranges::iterator_t<D>,
+                  ranges::iterator_t<ranges::range_reference_t<Srcs>>>
+  && splice_sortable_range<D, Comp, Proj>;
+
+/**
+ * @brief  Given a sorted spliceable range dst and a range of sorted
+ *         ranges srcs, performs a stable splice-based k-way merge of
+ *         all their elements into dst, leaving the ranges in srcs
+ *         empty
+ *
+ * The sources compete in a tournament (loser) tree, so that the
+ * merge takes O(n log k) comparisons for n elements in k ranges. The
+ * elements that come from the same source in a row are spliced into
+ * dst with a single cosplice() call. The merge is stable, i.e., the
+ * equivalent elements of dst go first and the ones of the ranges in
+ * srcs follow them in the order of srcs. If only one non-empty
+ * source is left, its remaining elements are spliced as a whole (but
+ * finding its last element takes a traversal unless it is a corange)
+ *
+ * @tparam Comp must be a strict weak order (see above)
+ * @note   Unlike std::list<T>::merge(), the function takes an
+ *         arbitrary number of ranges, but still requires that the
+ *         splicing between them is possible (e.g., the lists must
+ *         have equal allocators). The behaviour is undefined if dst
+ *         is in srcs or any of the ranges are not sorted. The function
+ *         allocates O(k) additional memory
+ **/
+template <spliceable_range D, typename Srcs,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(merge_spliceable_ranges<Srcs, D, Comp, Proj>)
+constexpr void merge_splice(D&& dst, Srcs&& srcs,
+                            const Comp comp = {}, const Proj proj = {}) {
+  merge_splice(default_sort_policy{}, std::forward<D>(dst),
+               std::forward<Srcs>(srcs), comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, spliceable_range D, typename Srcs,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(merge_spliceable_ranges<Srcs, D, Comp, Proj>)
+constexpr void merge_splice(const Policy& policy, D&& dst, Srcs&& srcs,
+                            const Comp comp = {}, const Proj proj = {}) {
+  using src_t = std::remove_reference_t<ranges::range_reference_t<Srcs>>;
+
+  std::vector<src_t*> ptrs;
+  for (auto& src : srcs) ptrs.push_back(std::addressof(src));
+
+  __detail::merge_splice(std::forward<D>(dst), ptrs,
+                         __detail::project_predicate(comp, proj, policy),
+                         policy);
+}
+
+/**
+ * @brief  Given a sorted open interval (dst_left, dst_right) of a
+ *         spliceable range and a sorted open interval (src_left,
+ *         src_right) of another one, performs a stable splice-based
+ *         merge of the latter into the former, and returns an
+ *         iterator to the last element of the merged interval
+ *
+ * The runs of the source elements that go between the same
+ * destination ones are spliced right into their final positions with
+ * a single cosplice() call each, so neither of the intervals is
+ * traversed more than once. The equivalent elements of the
+ * destination go first
+ *
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  dst_left must be a valid left limit of dst_range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  dst_right must be a valid right limit of dst_range (i.e., a
+ *         sentinel equal to end(dst_range) or a dereferenceable
+ *         iterator)
+ * @param  src_left must be a valid left limit of src_range
+ * @param  src_right must be a valid right limit of src_range
+ * @return An iterator to the last element of the merged interval in
+ *         dst_range (or after(dst_range, dst_left) if it is empty)
+ * @note   Finding the last element takes a traversal of the rest of
+ *         the destination interval (or of the source one, if its
+ *         elements go last), unless the corresponding right limit is
+ *         a bidirectional iterator. The behaviour is undefined if
+ *         either of the intervals is not sorted, or they overlap
+ **/
+template <spliceable_range D, left_limit_of<D> L1, right_limit_of<D> L2,
+          ranges::forward_range S, left_limit_of<S> L3, right_limit_of<S> L4,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(spliceable_with_range<D, S>
+           && std::same_as<ranges::iterator_t<D>, ranges::iterator_t<S>>
+           && splice_sortable_range<D, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<D> merge_splice
+  (D&& dst_range, const L1 dst_left, const L2 dst_right,
+   S&& src_range, const L3 src_left, const L4 src_right,
+   const Comp comp = {}, const Proj proj = {}) {
+  return merge_splice(default_sort_policy{}, std::forward<D>(dst_range),
+                      dst_left, dst_right, std::forward<S>(src_range),
+                      src_left, src_right, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy,
+          spliceable_range D, left_limit_of<D> L1, right_limit_of<D> L2,
+          ranges::forward_range S, left_limit_of<S> L3, right_limit_of<S> L4,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(spliceable_with_range<D, S>
+           && std::same_as<ranges::iterator_t<D>, ranges::iterator_t<S>>
+           && splice_sortable_range<D, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<D> merge_splice
+  (const Policy& policy, D&& dst_range, const L1 dst_left,
+   const L2 dst_right, S&& src_range, const L3 src_left,
+   const L4 src_right, const Comp comp = {}, const Proj proj = {}) {
+  return
+    __detail::merge_splice(std::forward<D>(dst_range), dst_left, dst_right,
+                           std::forward<S>(src_range), src_left, src_right,
+                           __detail::project_predicate(comp, proj, policy),
+                           policy);
+}
+
+/**
+ * @brief  Removes all but the first element from every group of
+ *         consecutive equivalent elements in the open interval (left,
+ *         right) of the given range, by splicing them into the discard
+ *         range, and returns the number of the removed elements
+ *
+ * Every run of duplicates is spliced out with a single cosplice()
+ * call, so the nodes are neither destroyed nor deallocated, and it is
+ * up to the caller to do that in batches (e.g., by clearing the
+ * discard range) or reuse them. The removed elements are put to the
+ * front of the discard range in their original order
+ *
+ * @tparam EqRel must be an equivalence relation
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The number of elements removed from the interval
+ * @note   Like std::unique(), the function compares every element with
+ *         the first one of its group, so it removes all the duplicates
+ *         only if the interval is sorted (or at least has all the
+ *         equivalent elements grouped together)
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          ranges::forward_range D,
+          typename EqRel = ranges::equal_to, typename Proj = std::identity>
+  requires(spliceable_with_range<D, R>
+           && std::same_as<ranges::iterator_t<D>, ranges::iterator_t<R>>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj>>)
+constexpr size_t unique_splice(R&& range, const L1 left, const L2 right,
+                               D&& discard_range,
+                               const EqRel rel = {}, const Proj proj = {}) {
+  return __detail::unique_splice(std::forward<R>(range), left, right,
+                                 std::forward<D>(discard_range),
+                                 __detail::project_predicate(rel, proj));
+}
+
+/**
+ * @brief  Removes all but the first element from every group of
+ *         consecutive equivalent elements in the given range, by
+ *         splicing them into the discard range (see above for
+ *         details), and returns the number of the removed elements
+ * @tparam EqRel must be an equivalence relation
+ * @return The number of elements removed from the range
+ **/
+template <spliceable_range R, ranges::forward_range D,
+          typename EqRel = ranges::equal_to, typename Proj = std::identity>
+  requires(spliceable_with_range<D, R>
+           && std::same_as<ranges::iterator_t<D>, ranges::iterator_t<R>>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj>>)
+constexpr size_t unique_splice(R&& range, D&& discard_range,
+                               const EqRel rel = {}, const Proj proj = {}) {
+  return unique_splice(std::forward<R>(range), before_begin(range),
+                       ranges::end(range), std::forward<D>(discard_range),
+                       rel, proj);
+}
+
+/**
+ * @brief The concept of ranges that can be combined with the
+ *        splice-based set operations with the provided strict weak
+ *        order or three-way comparator, i.e., the elements can be
+ *        spliced between them and into the range of type L (for the
+ *        leftover elements)
+ **/
+template <typename R1, typename R2, typename L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+concept set_spliceable_ranges = spliceable_with_range<R1, R2>
+  && spliceable_with_range<L, R1> && spliceable_with_range<L, R2>
+  && std::same_as<ranges::iterator_t<R1>, ranges::iterator_t<R2>>
+  && std::same_as<ranges::iterator_t<R1>, ranges::iterator_t<L>>
+  && (splice_sortable_range<R1, Comp, Proj>
+      || three_way_sortable_range<R1, Comp, Proj>);
+
+/**
+ * @brief  Merges the elements of the sorted range second that are not
+ *         matched by the ones of the sorted range first into it by
+ *         splicing, so that first becomes their sorted union
+ *
+ * As with std::set_union(), if an element is found m times in first
+ * and n times in second, then first keeps its m elements, and the
+ * last max(n - m, 0) of the ones in second are merged into it.
+ *
+ * Nothing is allocated or copied: the elements are moved in runs with
+ * a single cosplice() call each, and the ones that are not in the
+ * result (i.e., the matched elements of second here) are put to the
+ * front of the leftover range, in the order they would be merged in.
+ * Thus, second is always left empty
+ *
+ * @tparam Comp must be a strict weak order, or a three-way comparator
+ *         (see three_way_sortable_range), which then tells the order
+ *         of a pair of elements with a single call instead of two
+ * @note   The behaviour is undefined if either of first and second is
+ *         not sorted. If the rest of one of the ranges has to be
+ *         moved as a whole, finding its last element takes a
+ *         traversal, unless the range is bidirectional and common
+ **/
+template <ranges::forward_range R1, ranges::forward_range R2,
+          ranges::forward_range L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(set_spliceable_ranges<R1, R2, L, Comp, Proj>)
+constexpr void set_union_splice
+  (R1&& first, R2&& second, L&& leftover,
+   const Comp comp = {}, const Proj proj = {}) {
+  __detail::set_operation_splice<true, true, true>
+    (std::forward<R1>(first), std::forward<R2>(second),
+     std::forward<L>(leftover),
+     __detail::project_order<ranges::iterator_t<R1>>(comp, proj));
+}
+
+/**
+ * @brief  Leaves only the elements of the sorted range first that are
+ *         matched by the ones of the sorted range second in it, so
+ *         that first becomes their sorted intersection. The rest of
+ *         the elements of both ranges are spliced into the leftover
+ *         range (see set_union_splice for details)
+ *
+ * As with std::set_intersection(), if an element is found m times in
+ * first and n times in second, then first keeps the first min(m, n)
+ * of its elements
+ *
+ * @tparam Comp must be a strict weak order or a three-way comparator
+ *         (see set_union_splice)
+ **/
+template <ranges::forward_range R1, ranges::forward_range R2,
+          ranges::forward_range L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(set_spliceable_ranges<R1, R2, L, Comp, Proj>)
+constexpr void set_intersection_splice
+  (R1&& first, R2&& second, L&& leftover,
+   const Comp comp = {}, const Proj proj = {}) {
+  __detail::set_operation_splice<false, false, true>
+    (std::forward<R1>(first), std::forward<R2>(second),
+     std::forward<L>(leftover),
+     __detail::project_order<ranges::iterator_t<R1>>(comp, proj));
+}
+
+/**
+ * @brief  Leaves only the elements of the sorted range first that are
+ *         not matched by the ones of the sorted range second in it,
+ *         so that first becomes their sorted difference. The rest of
+ *         the elements of both ranges are spliced into the leftover
+ *         range (see set_union_splice for details)
+ *
+ * As with std::set_difference(), if an element is found m times in
+ * first and n times in second, then first keeps the last max(m - n,
+ * 0) of its elements
+ *
+ * @tparam Comp must be a strict weak order or a three-way comparator
+ *         (see set_union_splice)
+ **/
+template <ranges::forward_range R1, ranges::forward_range R2,
+          ranges::forward_range L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(set_spliceable_ranges<R1, R2, L, Comp, Proj>)
+constexpr void set_difference_splice
+  (R1&& first, R2&& second, L&& leftover,
+   const Comp comp = {}, const Proj proj = {}) {
+  __detail::set_operation_splice<true, false, false>
+    (std::forward<R1>(first), std::forward<R2>(second),
+     std::forward<L>(leftover),
+     __detail::project_order<ranges::iterator_t<R1>>(comp, proj));
+}
+
+/**
+ * @brief  Leaves only the elements of the sorted ranges first and
+ *         second that are not matched by each other in first, so
+ *         that it becomes their sorted symmetric difference. The rest
+ *         of the elements are spliced into the leftover range (see
+ *         set_union_splice for details)
+ *
+ * As with std::set_symmetric_difference(), if an element is found m
+ * times in first and n times in second, then first keeps the last
+ * m - n of its elements if m > n, and the last n - m of the ones in
+ * second are merged into it otherwise
+ *
+ * @tparam Comp must be a strict weak order or a three-way comparator
+ *         (see set_union_splice)
+ **/
+template <ranges::forward_range R1, ranges::forward_range R2,
+          ranges::forward_range L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(set_spliceable_ranges<R1, R2, L, Comp, Proj>)
+constexpr void set_symmetric_difference_splice
+  (R1&& first, R2&& second, L&& leftover,
+   const Comp comp = {}, const Proj proj = {}) {
+  __detail::set_operation_splice<true, true, false>
+    (std::forward<R1>(first), std::forward<R2>(second),
+     std::forward<L>(leftover),
+     __detail::project_order<ranges::iterator_t<R1>>(comp, proj));
+}
+
+/**
+ * @brief The concept of a range, the elements of which can be grouped
+ *        by their keys (projected with Proj) by splicing, with the
+ *        hash function Hash and the equivalence relation EqRel on the
+ *        keys (see group_by_splice)
+ **/
+template <typename R, typename Proj = std::identity,
+          typename Hash = std::hash
+            <std::remove_cvref_t<__detail::group_key_t<R, Proj>>>,
+          typename EqRel = ranges::equal_to>
+concept groupable_range = spliceable_range<R>
+  && std::indirect_equivalence_relation
+     <EqRel, std::projected<ranges::iterator_t<R>, Proj>>
+  && std::regular_invocable<const Hash&, __detail::group_key_t<R, Proj>>
+  && std::convertible_to
+     <std::invoke_result_t<const Hash&, __detail::group_key_t<R, Proj>>,
+      size_t>;
+
+/**
+ * @brief  Groups the elements of the open interval (left, right) in
+ *         the given range by their keys (projected with proj) by
+ *         splicing, so that the elements with equivalent keys follow
+ *         each other, and returns the groups
+ *
+ * Unlike bucket_sort_splice, this requires no order on the keys: the
+ * groups are laid out in the order of their first elements, and the
+ * elements keep their relative order inside every group. The groups
+ * are looked up in an open addressing hash table, so it takes O(n)
+ * expected time, and every run of consecutive elements of the same
+ * group is moved with a single cosplice() call
+ *
+ * @tparam Hash must give the same values for equivalent keys
+ * @tparam EqRel must be an equivalence relation
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The sizes and the last elements of the groups in their
+ *         order, so that the first group is (left, last_0] and every
+ *         next one is (last_{i-1}, last_i]
+ * @note   The keys are not stored, the last element of a group is
+ *         used to compare against instead. If the hash function or
+ *         the relation throws, the range is left grouped partially
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity,
+          typename Hash = std::hash
+            <std::remove_cvref_t<__detail::group_key_t<R, Proj>>>,
+          typename EqRel = ranges::equal_to>
+  requires(groupable_range<R, Proj, Hash, EqRel>)
+std::vector<std::pair<size_t, ranges::borrowed_iterator_t<R>>>
+  group_by_splice(R&& range, const L1 left, const L2 right,
+                  const Proj proj = {}, const Hash hash = {},
+                  const EqRel rel = {}) {
+  std::allocator<std::byte> alloc;
+  return __detail::group_by_splice(std::forward<R>(range), left, right,
+                                   alloc, proj, hash,
+                                   __detail::project_predicate(rel, proj));
+}
+
+/**
+ * @brief  Same as the above, but uses a custom allocator for the hash
+ *         table and the returned groups
+ * @return The sizes and the last elements of the groups in their
+ *         order, in a vector with the allocator rebound from the
+ *         given one
+ **/
+template <typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity,
+          typename Hash = std::hash
+            <std::remove_cvref_t<__detail::group_key_t<R, Proj>>>,
+          typename EqRel = ranges::equal_to>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && groupable_range<R, Proj, Hash, EqRel>)
+__detail::rebound_vector<std::pair<size_t, ranges::borrowed_iterator_t<R>>,
+                         Allocator>
+  group_by_splice(Allocator&& alloc, R&& range,
+                  const L1 left, const L2 right,
+                  const Proj proj = {}, const Hash hash = {},
+                  const EqRel rel = {}) {
+  return __detail::group_by_splice(std::forward<R>(range), left, right,
+                                   alloc, proj, hash,
+                                   __detail::project_predicate(rel, proj));
+}
+
+/**
+ * @brief  Groups the elements of the given range by their keys by
+ *         splicing (see above for details) and returns the groups
+ * @tparam Hash must give the same values for equivalent keys
+ * @tparam EqRel must be an equivalence relation
+ * @return The sizes and the last elements of the groups in their
+ *         order
+ **/
+template <spliceable_range R, typename Proj = std::identity,
+          typename Hash = std::hash
+            <std::remove_cvref_t<__detail::group_key_t<R, Proj>>>,
+          typename EqRel = ranges::equal_to>
+  requires(groupable_range<R, Proj, Hash, EqRel>)
+std::vector<std::pair<size_t, ranges::borrowed_iterator_t<R>>>
+  group_by_splice(R&& range, const Proj proj = {}, const Hash hash = {},
+                  const EqRel rel = {}) {
+  return group_by_splice(std::forward<R>(range), before_begin(range),
+                         ranges::end(range), proj, hash, rel);
+}
+
+/**
+ * @brief  Groups the elements of the given range by their keys by
+ *         splicing (see above for details), using a custom allocator
+ *         for the hash table and the returned groups
+ * @tparam Hash must give the same values for equivalent keys
+ * @tparam EqRel must be an equivalence relation
+ * @return The sizes and the last elements of the groups in their
+ *         order
+ **/
+template <typename Allocator, spliceable_range R,
+          typename Proj = std::identity,
+          typename Hash = std::hash
+            <std::remove_cvref_t<__detail::group_key_t<R, Proj>>>,
+          typename EqRel = ranges::equal_to>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && groupable_range<R, Proj, Hash, EqRel>)
+__detail::rebound_vector<std::pair<size_t, ranges::borrowed_iterator_t<R>>,
+                         Allocator>
+  group_by_splice(Allocator&& alloc, R&& range, const Proj proj = {},
+                  const Hash hash = {}, const EqRel rel = {}) {
+  return group_by_splice(std::forward<Allocator>(alloc),
+                         std::forward<R>(range), before_begin(range),
+                         ranges::end(range), proj, hash, rel);
+}
+
 /**
  * @brief  Performs a splice-based version of the stable insertion
  *         sorting algorithm on the corange (left, left + count] and
@@ -130,9 +913,24 @@ template <spliceable_range R, left_limit_of<R> L,
 constexpr ranges::borrowed_iterator_t<R> insertion_sort_splice
   (R&& range, const L left, const size_t count,
    const Comp comp = {}, const Proj proj = {}) {
+  return insertion_sort_splice(default_sort_policy{}, std::forward<R>(range),
+                               left, count, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> insertion_sort_splice
+  (const Policy& policy, R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
   return
     __detail::insertion_sort_splice(std::forward<R>(range), left, count,
-                                    __detail::project_predicate(comp, proj));
+                                    __detail::project_predicate(comp, proj,
+                                                                policy),
+                                    policy);
 }
 
 /**
@@ -172,8 +970,47 @@ template <spliceable_range R, left_limit_of<R> L,
 constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
   (R&& range, const L left, const size_t count,
    const Comp comp = {}, const Proj proj = {}) {
-  return __detail::merge_sort_splice(std::forward<R>(range), left, count,
-                                     __detail::project_predicate(comp, proj));
+  return merge_sort_splice(default_sort_policy{}, std::forward<R>(range),
+                           left, count, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy and, if it
+ *        caches the keys (see key_caching_sort_policy), the given
+ *        allocator for the cached keys
+ **/
+template <sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
+  (const Policy& policy, Allocator&& alloc,
+   R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  return __detail::sort_with_keys
+    (range, left, ranges::end(range), count, alloc,
+     [&](auto& r, const auto l, auto, const auto& key_of) {
+       return std::make_pair
+         (count, __detail::merge_sort_splice
+                   (r, l, count,
+                    __detail::project_predicate(comp, key_of, policy),
+                    policy));
+     }, policy, proj).second;
+}
+
+/**
+ * @brief Same as the above, but allocates the cached keys (if any)
+ *        with std::allocator
+ **/
+template <sort_policy Policy, spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
+  (const Policy& policy, R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  return merge_sort_splice(policy, std::allocator<std::byte>{},
+                           std::forward<R>(range), left, count, comp, proj);
 }
 
 /**
@@ -194,46 +1031,18 @@ constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
 }
 
 /**
- * @brief  Performs a splice-based version of the bucket sorting
- *         algorithm on the open interval (left, right) in the given
- *         range, using a strict weak order and an equivalence
- *         relation that is weakly consistent with it. If the relation
- *         is (totally) consistent with the order, then the sorting is
- *         stable.
- *
- * A predicate (denoted by x~y) is an equivalence relation if (x~x),
- * (x~y => y~x) and (x~y & y~z => x~z) for all x, y and z.
- *
- * We say that an equivalence relation is weakly consistent with a
- * strict weak order (denoted by x<y with its negation !(x<y) denoted
- * by x>=y) iff (x<y & x~a & y~b) implies (a<b or a~b) for all x, y,
- * a, b. Or, equivalently, the relation x<'y <=> x<y & !(x~y) is a
- * strict weak order.
- *
- * Put simply, weak consistency means that any pair of elements from
- * two different equivalence classes (i.e. buckets) compare the
- * same. An example of such a relation on positive integers, weakly
- * consistent with the natural order (<), is: x~y <=> (x>>k) == (y>>k)
- * for some k.
- *
- * An equivalence relation is (totally) consistent with a strict weak
- * order iff it is weakly consistent with it and additionally (x>=y &
- * y>=x) implies x~y. Equivalently, x<'y induces a (strict) total
- * order on equivalency classes.
- *
- * In the bit shift example above the relation is also (totally)
- * consistent with the natural order.
+ * @brief  Performs a bottom-up splice-based version of the stable
+ *         merge sorting algorithm on the open interval (left, right)
+ *         in the given range, without knowing its size in advance
  *
- * To get the best performance, one should choose a relation that
- * gives not-too-many buckets rougly equal in size. As corner cases,
- * if none of the elements are equivalent, the algorithm degrades to
- * insertion_sort; if all elements are equivalent, it degrades to
- * merge_sort with an extra traversal of the entire range
+ * The interval is traversed only once: it is cut into small runs
+ * sorted with insertions, which are then merged into a fixed array
+ * of runs acting as a binary counter (like in the libstdc++
+ * implementation of std::list<T>::sort). Unlike the counted version,
+ * this one never walks the range to find the split points, which
+ * makes it preferable for long ranges of unknown size (e.g.,
+ * std::forward_list)
  *
- * @tparam _max_buckets is the maximum number of equivalence classes
- *         used for the given interval
- * @tparam EqRel must be an equivalence relation weakly consistent
- *         with Comp (see above)
  * @tparam Comp must be a strict weak order (see above)
  * @param  left must be a valid left limit of the given range (i.e., a
  *         front sentinel or a dereferenceable iterator)
@@ -243,13 +1052,422 @@ constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
  * @return The size of the sorted interval and an iterator to its last
  *         element after sorting (or after(range, left) if the
  *         interval is empty)
- * @note   If the real number of buckets is bigger than _max_buckets,
- *         the algorithm will still work correctly but a little less
- *         efficiently, as it will require an additional inplace_merge
- * @note   The algorithm uses additional (_max_buckets *
- *         (sizeof(pair<size_t, iterator_t<R>>) + sizeof(T))) bytes of
- *         memory on the stack, where T is the minimal unsigned type
- *         capable of holding _max_buckets (e.g., uint8_t if it is <=
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> merge_sort_splice
+  (R&& range, const L1 left, const L2 right,
+   const Comp comp = {}, const Proj proj = {}) {
+  return merge_sort_splice(default_sort_policy{}, std::forward<R>(range),
+                           left, right, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy and, if it
+ *        caches the keys (see key_caching_sort_policy), the given
+ *        allocator for the cached keys
+ **/
+template <sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> merge_sort_splice
+  (const Policy& policy, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const Comp comp = {}, const Proj proj = {}) {
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&](auto& r, const auto l, const auto end, const auto& key_of) {
+       return __detail::merge_sort_splice
+         (r, l, end, __detail::project_predicate(comp, key_of, policy),
+          policy);
+     }, policy, proj);
+}
+
+/**
+ * @brief Same as the above, but allocates the cached keys (if any)
+ *        with std::allocator
+ **/
+template <sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> merge_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const Comp comp = {}, const Proj proj = {}) {
+  return merge_sort_splice(policy, std::allocator<std::byte>{},
+                           std::forward<R>(range), left, right, comp, proj);
+}
+
+/**
+ * @brief  Performs a bottom-up splice-based version of the stable
+ *         merge sorting algorithm on the given range of unknown size
+ *         and returns an iterator to its last element
+ * @tparam Comp must be a strict weak order (see above)
+ * @return An iterator to the last element of the range (or equal to
+ *         end(range) if the range is empty)
+ **/
+template <spliceable_range R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(!ranges::sized_range<R> && splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> merge_sort_splice
+  (R&& range, const Comp comp = {}, const Proj proj = {}) {
+  return merge_sort_splice(std::forward<R>(range), before_begin(range),
+                           ranges::end(range), comp, proj).second;
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable natural
+ *         (run-adaptive) merge sorting algorithm on the open interval
+ *         (left, right) in the given range
+ *
+ * The interval is traversed once to detect the existing runs: the
+ * non-descending ones are taken as is, the strictly descending ones
+ * are reversed by splicing (very short runs are extended with
+ * insertions). The runs are then merged using the TimSort stack
+ * policy. Thus, sorting an already sorted range takes n-1
+ * comparisons, and a range consisting of k runs is sorted in O(n log
+ * k) time, which makes this algorithm a good choice for almost sorted
+ * ranges
+ *
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ **/
+template <spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+  natural_merge_sort_splice(R&& range, const L1 left, const L2 right,
+                            const Comp comp = {}, const Proj proj = {}) {
+  return natural_merge_sort_splice(default_sort_policy{},
+                                   std::forward<R>(range), left, right,
+                                   comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+  natural_merge_sort_splice(const Policy& policy, R&& range,
+                            const L1 left, const L2 right,
+                            const Comp comp = {}, const Proj proj = {}) {
+  return
+    __detail::natural_merge_sort_splice(std::forward<R>(range), left, right,
+                                        __detail::project_predicate(comp,
+                                                                    proj,
+                                                                    policy),
+                                        policy);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable natural
+ *         (run-adaptive) merge sorting algorithm on the given range
+ *         (see above for details) and returns an iterator to its last
+ *         element
+ * @tparam Comp must be a strict weak order (see above)
+ * @return An iterator to the last element of the range (or equal to
+ *         end(range) if the range is empty)
+ **/
+template <spliceable_range R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> natural_merge_sort_splice
+  (R&& range, const Comp comp = {}, const Proj proj = {}) {
+  return natural_merge_sort_splice(std::forward<R>(range), before_begin(range),
+                                   ranges::end(range), comp, proj).second;
+}
+
+/**
+ * @brief  Puts the k smallest elements of the corange (left, left +
+ *         count] in sorted order right after left with a splice-based
+ *         partial sorting algorithm, and returns an iterator to the
+ *         k-th element
+ *
+ * The k smallest elements seen so far are kept sorted at the front,
+ * while the elements less than the greatest of them are gathered into
+ * a batch. Once there are k elements in the batch, it is merge sorted
+ * and merged into the front part. Thus, the algorithm takes O(n log k)
+ * comparisons (and only about n once the smallest elements are found,
+ * e.g., on random data). The sorting is stable in the sense that the
+ * first k elements are the same (and in the same order) as after the
+ * stable sorting of the whole corange. The rest of the elements follow
+ * them in an unspecified order
+ *
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  count must not be greater than the number of elements
+ *         following left in the given range
+ * @return An iterator to the k-th element of the corange after sorting
+ *         (or to its last element if k > count, or after(range, left)
+ *         if k or count is zero)
+ **/
+template <spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> partial_sort_splice
+  (R&& range, const L left, const size_t count, const size_t k,
+   const Comp comp = {}, const Proj proj = {}) {
+  return partial_sort_splice(default_sort_policy{}, std::forward<R>(range),
+                             left, count, k, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> partial_sort_splice
+  (const Policy& policy, R&& range, const L left, const size_t count,
+   const size_t k, const Comp comp = {}, const Proj proj = {}) {
+  return
+    __detail::partial_sort_splice(std::forward<R>(range), left, count, k,
+                                  __detail::project_predicate(comp, proj,
+                                                              policy),
+                                  policy);
+}
+
+/**
+ * @brief  Puts the k smallest elements of the given sized range in
+ *         sorted order at its front with a splice-based partial
+ *         sorting algorithm (see above for details), and returns an
+ *         iterator to the k-th element
+ * @tparam Comp must be a strict weak order (see above)
+ * @return An iterator to the k-th element of the range after sorting
+ *         (or to its last element if k > size(range), or
+ *         begin(range) if k is zero or the range is empty)
+ **/
+template <spliceable_range R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(ranges::sized_range<R> && splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> partial_sort_splice
+  (R&& range, const size_t k, const Comp comp = {}, const Proj proj = {}) {
+  return partial_sort_splice(std::forward<R>(range), before_begin(range),
+                             ranges::size(range), k, comp, proj);
+}
+
+/**
+ * @brief  Rearranges the corange (left, left + count] by splicing, so
+ *         that its n-th element (counting from 0) is the one that
+ *         would be there if the corange was sorted, all the elements
+ *         before it are not greater than it, and all the elements
+ *         after it are not less than it. Returns an iterator to the
+ *         n-th element
+ *
+ * Two pivots are chosen from a sample of evenly spaced elements, so
+ * that the n-th element most likely falls between them, while only a
+ * small part of the elements does (like in the Floyd-Rivest
+ * algorithm). The corange is then partitioned into three parts by the
+ * pivots in one pass, and the process is repeated in the part that
+ * contains the n-th element. That takes O(n) time (and about 2.5
+ * traversals of the corange) on average, and if the depth of
+ * partitioning gets too big, the part is merge sorted instead (like
+ * in introselect), so O(n log n) in the worst case. The partitioning
+ * is stable, so the n-th element is the same as after the stable
+ * sorting of the corange
+ *
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  count must not be greater than the number of elements
+ *         following left in the given range
+ * @param  n must be less than count
+ * @return An iterator to the n-th element of the corange
+ * @note   The algorithm uses additional 256 * sizeof(iterator_t<R>)
+ *         bytes of memory on the stack for the sample
+ **/
+template <spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> nth_element_splice
+  (R&& range, const L left, const size_t count, const size_t n,
+   const Comp comp = {}, const Proj proj = {}) {
+  return nth_element_splice(default_sort_policy{}, std::forward<R>(range),
+                            left, count, n, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> nth_element_splice
+  (const Policy& policy, R&& range, const L left, const size_t count,
+   const size_t n, const Comp comp = {}, const Proj proj = {}) {
+  __detail::nth_element_sample<R> sample;
+  return
+    __detail::nth_element_splice(std::forward<R>(range), left, count, n,
+                                 2 * std::bit_width(count),
+                                 __detail::project_predicate(comp, proj,
+                                                             policy),
+                                 sample, policy);
+}
+
+/**
+ * @brief  Rearranges the given sized range by splicing, so that its
+ *         n-th element (counting from 0) is the one that would be
+ *         there if the range was sorted (see above for details), and
+ *         returns an iterator to it
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  n must be less than size(range)
+ * @return An iterator to the n-th element of the range
+ **/
+template <spliceable_range R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(ranges::sized_range<R> && splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> nth_element_splice
+  (R&& range, const size_t n, const Comp comp = {}, const Proj proj = {}) {
+  return nth_element_splice(std::forward<R>(range), before_begin(range),
+                            ranges::size(range), n, comp, proj);
+}
+
+/**
+ * @brief  Performs a splice-based version of the quick sorting
+ *         algorithm on the corange (left, left + count] and returns an
+ *         iterator to its last element
+ *
+ * The corange is partitioned in one pass into three parts: the
+ * elements less than, equivalent to and greater than the pivot, and
+ * the first and the last parts are sorted recursively, so the
+ * equivalent elements are done with at once. The pivot is the median
+ * of a few evenly spaced elements of a part, which are gathered while
+ * its parent is partitioned, so that choosing it doesn't take another
+ * traversal. Since a partitioning pass over a linked range costs
+ * about as much as a merging one, but is only worth it when it gets
+ * rid of many equivalent elements, a part is merge sorted instead if
+ * there are no equivalent elements in its sample, as well as when the
+ * depth of partitioning gets too big (like in introsort). Thus, the
+ * algorithm is never much slower than merge_sort_splice, and is much
+ * faster for ranges with few distinct elements (O(n log d) for d
+ * distinct ones). The partitioning by splicing is stable without any
+ * additional cost, and so is the sorting
+ *
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  count must not be greater than the number of elements
+ *         following left in the given range
+ * @return An iterator to the last element of the sorted corange (or
+ *         after(range, left) if count is zero)
+ **/
+template <spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> quick_sort_splice
+  (R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  return quick_sort_splice(default_sort_policy{}, std::forward<R>(range),
+                           left, count, comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, spliceable_range R, left_limit_of<R> L,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> quick_sort_splice
+  (const Policy& policy, R&& range, const L left, const size_t count,
+   const Comp comp = {}, const Proj proj = {}) {
+  return
+    __detail::quick_sort_splice(std::forward<R>(range), left, count,
+                                2 * std::bit_width(count),
+                                __detail::project_predicate(comp, proj,
+                                                            policy),
+                                __detail::quick_sort_sample<R>{}, policy);
+}
+
+/**
+ * @brief  Sorts the given sized range with a splice-based quick
+ *         sorting algorithm (see above for details), and returns an
+ *         iterator to its last element
+ * @tparam Comp must be a strict weak order (see above)
+ * @return An iterator to the last element of the sorted range (or
+ *         begin(range) if it is empty)
+ **/
+template <spliceable_range R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(ranges::sized_range<R> && splice_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> quick_sort_splice
+  (R&& range, const Comp comp = {}, const Proj proj = {}) {
+  return quick_sort_splice(std::forward<R>(range), before_begin(range),
+                           ranges::size(range), comp, proj);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the open interval (left, right) in the given
+ *         range, using a strict weak order and an equivalence
+ *         relation that is weakly consistent with it. If the relation
+ *         is (totally) consistent with the order, then the sorting is
+ *         stable.
+ *
+ * A predicate (denoted by x~y) is an equivalence relation if (x~x),
+ * (x~y => y~x) and (x~y & y~z => x~z) for all x, y and z.
+ *
+ * We say that an equivalence relation is weakly consistent with a
+ * strict weak order (denoted by x<y with its negation !(x<y) denoted
+ * by x>=y) iff (x<y & x~a & y~b) implies (a<b or a~b) for all x, y,
+ * a, b. Or, equivalently, the relation x<'y <=> x<y & !(x~y) is a
+ * strict weak order.
+ *
+ * Put simply, weak consistency means that any pair of elements from
+ * two different equivalence classes (i.e. buckets) compare the
+ * same. An example of such a relation on positive integers, weakly
+ * consistent with the natural order (<), is: x~y <=> (x>>k) == (y>>k)
+ * for some k.
+ *
+ * An equivalence relation is (totally) consistent with a strict weak
+ * order iff it is weakly consistent with it and additionally (x>=y &
+ * y>=x) implies x~y. Equivalently, x<'y induces a (strict) total
+ * order on equivalency classes.
+ *
+ * In the bit shift example above the relation is also (totally)
+ * consistent with the natural order.
+ *
+ * To get the best performance, one should choose a relation that
+ * gives not-too-many buckets rougly equal in size. As corner cases,
+ * if none of the elements are equivalent, the algorithm degrades to
+ * insertion_sort; if all elements are equivalent, it degrades to
+ * merge_sort with an extra traversal of the entire range. The bucket
+ * of an element is found with a binary search, so even thousands of
+ * buckets only cost a few comparisons per element
+ *
+ * @tparam _max_buckets is the maximum number of equivalence classes
+ *         used for the given interval
+ * @tparam EqRel must be an equivalence relation weakly consistent
+ *         with Comp (see above)
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   If the real number of buckets is bigger than _max_buckets,
+ *         the algorithm will still work correctly but a little less
+ *         efficiently, as it will require an additional inplace_merge
+ * @note   The algorithm uses additional (_max_buckets *
+ *         (sizeof(pair<size_t, iterator_t<R>>) + sizeof(T))) bytes of
+ *         memory on the stack, where T is the minimal unsigned type
+ *         capable of holding _max_buckets (e.g., uint8_t if it is <=
  *         255). If that is too much stack memory, consider using the
  *         version that takes an allocator
  **/
@@ -264,11 +1482,36 @@ constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
   (R&& range, const L1 left, const L2 right,
    const EqRel rel, const Proj1 proj1 = {},
    const Comp comp = {}, const Proj2 proj2 = {}) {
-  __detail::bucket_sort_splice_data<_max_buckets, R> data;
-  return __detail::bucket_sort_splice(std::forward<R>(range), left, right,
-                                      __detail::project_predicate(rel, proj1),
-                                      __detail::project_predicate(comp, proj2),
-                                      data);
+  return bucket_sort_splice<_max_buckets>(default_sort_policy{},
+                                          std::forward<R>(range), left, right,
+                                          rel, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _max_buckets = 32, sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  std::allocator<std::byte> alloc;
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& key1_of, const auto& key2_of) {
+       __detail::bucket_sort_splice_data
+         <_max_buckets, S&, Policy::merge_buckets> data;
+       return __detail::bucket_sort_splice
+         (r, l, end, __detail::project_predicate(rel, key1_of, policy),
+          __detail::project_predicate(comp, key2_of, policy), data, policy);
+     }, policy, proj1, proj2);
 }
 
 /**
@@ -300,27 +1543,145 @@ template <size_t _max_buckets = 32, typename Allocator,
           spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
           typename EqRel, typename Proj1 = std::identity,
           typename Comp = ranges::less, typename Proj2 = std::identity>
-  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+  requires(_max_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
            && std::indirect_equivalence_relation
               <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
 constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
   (Allocator&& alloc, R&& range, const L1 left, const L2 right,
    const EqRel rel, const Proj1 proj1 = {},
    const Comp comp = {}, const Proj2 proj2 = {}) {
-  auto data_ptr = __detail::allocate_bucket_sort_splice_data<_max_buckets, R>
-    (std::forward<Allocator>(alloc));
-  return
-    __detail::bucket_sort_splice(std::forward<R>(range), left, right,
-                                 __detail::project_predicate(rel, proj1),
-                                 __detail::project_predicate(comp, proj2),
-                                 *data_ptr);
+  return bucket_sort_splice<_max_buckets>(default_sort_policy{},
+                                          std::forward<Allocator>(alloc),
+                                          std::forward<R>(range), left, right,
+                                          rel, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _max_buckets = 32, sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& key1_of, const auto& key2_of) {
+       auto data_ptr = __detail::allocate_sort_data
+         <__detail::bucket_sort_splice_data<_max_buckets, S&,
+                                            Policy::merge_buckets>>(alloc);
+       return __detail::bucket_sort_splice
+         (r, l, end, __detail::project_predicate(rel, key1_of, policy),
+          __detail::project_predicate(comp, key2_of, policy),
+          *data_ptr, policy);
+     }, policy, proj1, proj2);
 }
 
 /**
  * @brief  Performs a splice-based version of the bucket sorting
- *         algorithm on the given range, using a strict weak order and
- *         an equivalence relation that is weakly consistent with it
- *         (see above for details). If the relation is (totally)
+ *         algorithm on the open interval (left, right) in the given
+ *         range (see above for details), with the maximum number of
+ *         equivalence classes chosen at runtime. If the relation is
+ *         (totally) consistent with the order, then the sorting is
+ *         stable
+ *
+ * Useful when the number of the keys is only known at runtime. The
+ * bucket data is allocated with the provided allocator, unless there
+ * are few enough buckets to fit on the stack
+ *
+ * @tparam EqRel must be an equivalence relation weakly consistent
+ *         with Comp (see above)
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  max_buckets is the maximum number of equivalence classes
+ *         used for the given interval (zero is treated as one)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   Opening a new bucket takes time linear in the number of
+ *         buckets (only their indices are shifted), so the algorithm
+ *         handles tens of thousands of buckets, but is best when most
+ *         elements fall into existing ones
+ **/
+template <typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const size_t max_buckets, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice(default_sort_policy{}, max_buckets,
+                            std::forward<Allocator>(alloc),
+                            std::forward<R>(range), left, right,
+                            rel, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, const size_t max_buckets, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& key1_of, const auto& key2_of) {
+       const auto is_eq = __detail::project_predicate(rel, key1_of, policy);
+       const auto less = __detail::project_predicate(comp, key2_of, policy);
+
+       if (max_buckets <= __detail::bucket_sort_inline_buckets) {
+         __detail::bucket_sort_splice_data
+           <__detail::bucket_sort_inline_buckets, S&, Policy::merge_buckets>
+           data(std::max<size_t>(max_buckets, 1));
+         return __detail::bucket_sort_splice(r, l, end, is_eq, less,
+                                             data, policy);
+       }
+
+       __detail::dynamic_bucket_sort_splice_data
+         <S&, std::remove_cvref_t<Allocator>, Policy::merge_buckets>
+         data(max_buckets, alloc);
+       return __detail::bucket_sort_splice(r, l, end, is_eq, less,
+                                           data, policy);
+     }, policy, proj1, proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the given range, using a strict weak order and
+ *         an equivalence relation that is weakly consistent with it
+ *         (see above for details). If the relation is (totally)
  *         consistent with the order, then the sorting is stable
  * @tparam _max_buckets is the maximum number of equivalence classes
  *         used for the given range
@@ -375,7 +1736,9 @@ constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
 template <size_t _max_buckets = 32, typename Allocator,
           spliceable_range R, typename EqRel, typename Proj1 = std::identity,
           typename Comp = ranges::less, typename Proj2 = std::identity>
-  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+  requires(_max_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
            && std::indirect_equivalence_relation
               <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
 constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
@@ -388,4 +1751,876 @@ constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
                                      rel, proj1, comp, proj2);
 }
 
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the given range with the maximum number of
+ *         equivalence classes chosen at runtime (see above for
+ *         details). If the relation is (totally) consistent with the
+ *         order, then the sorting is stable
+ * @tparam EqRel must be an equivalence relation weakly consistent
+ *         with Comp (see above)
+ * @tparam Comp must be a strict weak order (see above)
+ * @param  max_buckets is the maximum number of equivalence classes
+ *         used for the given range (zero is treated as one)
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <typename Allocator,
+          spliceable_range R, typename EqRel, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && std::indirect_equivalence_relation
+              <EqRel, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const size_t max_buckets, Allocator&& alloc, R&& range,
+   const EqRel rel, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice(max_buckets, std::forward<Allocator>(alloc),
+                            std::forward<R>(range),
+                            before_begin(range), ranges::end(range),
+                            rel, proj1, comp, proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the open interval (left, right) in the given
+ *         range, with the buckets given by the equivalence classes of
+ *         a three-way comparator of the projected keys. The sorting
+ *         is stable
+ *
+ * Same as the version with an equivalence relation (see above), but
+ * a single call of cmp tells whether an element is in a bucket, or
+ * goes before or after it, so a key is compared with a bucket once
+ * instead of twice (e.g., scanned once if it is a string). The
+ * buckets are ordered by cmp, so its order must be consistent with
+ * comp, i.e., cmp(proj1(x), proj1(y)) < 0 must imply
+ * comp(proj2(x), proj2(y)) (e.g., cmp compares the prefixes of the
+ * strings compared by comp)
+ *
+ * @tparam _max_buckets is the maximum number of equivalence classes
+ *         used for the given interval
+ * @tparam Cmp must be a three-way comparator consistent with Comp
+ *         (see above and three_way_sortable_range)
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   The algorithm uses as much memory on the stack as the version
+ *         with an equivalence relation
+ **/
+template <size_t _max_buckets = 32,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Cmp, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && three_way_sortable_range<R, Cmp, Proj1>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (R&& range, const L1 left, const L2 right,
+   const Cmp cmp, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice<_max_buckets>(default_sort_policy{},
+                                          std::forward<R>(range), left, right,
+                                          cmp, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _max_buckets = 32, sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Cmp, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && three_way_sortable_range<R, Cmp, Proj1>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const Cmp cmp, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  std::allocator<std::byte> alloc;
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& key1_of, const auto& key2_of) {
+       const auto order = __detail::project_predicate(cmp, key1_of, policy);
+       __detail::bucket_sort_splice_data
+         <_max_buckets, S&, Policy::merge_buckets> data;
+       return __detail::bucket_sort_splice
+         (r, l, end, __detail::three_way_equal{order},
+          __detail::three_way_less{order},
+          __detail::project_predicate(comp, key2_of, policy), data, policy);
+     }, policy, proj1, proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the open interval (left, right) in the given
+ *         range, with the buckets given by the equivalence classes of
+ *         a three-way comparator of the projected keys (see above for
+ *         details), using a custom allocator for additional
+ *         memory. The sorting is stable
+ * @tparam _max_buckets is the maximum number of equivalence classes
+ *         used for the given interval
+ * @tparam Cmp must be a three-way comparator consistent with Comp
+ *         (see above and three_way_sortable_range)
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ **/
+template <size_t _max_buckets = 32, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Cmp, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && three_way_sortable_range<R, Cmp, Proj1>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (Allocator&& alloc, R&& range, const L1 left, const L2 right,
+   const Cmp cmp, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice<_max_buckets>(default_sort_policy{},
+                                          std::forward<Allocator>(alloc),
+                                          std::forward<R>(range), left, right,
+                                          cmp, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _max_buckets = 32, sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Cmp, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && three_way_sortable_range<R, Cmp, Proj1>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const Cmp cmp, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& key1_of, const auto& key2_of) {
+       const auto order = __detail::project_predicate(cmp, key1_of, policy);
+       auto data_ptr = __detail::allocate_sort_data
+         <__detail::bucket_sort_splice_data<_max_buckets, S&,
+                                            Policy::merge_buckets>>(alloc);
+       return __detail::bucket_sort_splice
+         (r, l, end, __detail::three_way_equal{order},
+          __detail::three_way_less{order},
+          __detail::project_predicate(comp, key2_of, policy),
+          *data_ptr, policy);
+     }, policy, proj1, proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the given range, with the buckets given by the
+ *         equivalence classes of a three-way comparator of the
+ *         projected keys (see above for details). The sorting is
+ *         stable
+ * @tparam _max_buckets is the maximum number of equivalence classes
+ *         used for the given range
+ * @tparam Cmp must be a three-way comparator consistent with Comp
+ *         (see above and three_way_sortable_range)
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _max_buckets = 32, spliceable_range R,
+          typename Cmp, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_max_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && three_way_sortable_range<R, Cmp, Proj1>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (R&& range, const Cmp cmp, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return
+    bucket_sort_splice<_max_buckets>(std::forward<R>(range),
+                                     before_begin(range), ranges::end(range),
+                                     cmp, proj1, comp, proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the open interval (left, right) in the given
+ *         range, with the bucket of every element computed directly
+ *         by the function bucket_of. The sorting is stable
+ *
+ * No comparisons are made to find the buckets: the elements are
+ * spliced to the tails of their buckets in a single pass, then every
+ * bucket is sorted with the merge sort. For the result to be sorted,
+ * bucket_of must be monotone, i.e., x<y must imply bucket_of(x) <=
+ * bucket_of(y) (e.g., bucket_of(x) = x>>k on positive integers with
+ * the natural order)
+ *
+ * @tparam _buckets is the number of the buckets, i.e., bucket_of must
+ *         return a value less than _buckets for every element of the
+ *         interval
+ * @tparam BucketOf must be a monotone function (see above) from the
+ *         projected elements to bucket numbers
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   The algorithm uses additional (_buckets *
+ *         (sizeof(iterator_t<R>) + sizeof(size_t))) bytes of memory on
+ *         the stack. If that is too much stack memory, consider using
+ *         the version that takes an allocator
+ **/
+template <size_t _buckets,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename BucketOf, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && __detail::bucket_function
+              <BucketOf, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (R&& range, const L1 left, const L2 right,
+   const BucketOf bucket_of, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice<_buckets>(default_sort_policy{},
+                                      std::forward<R>(range), left, right,
+                                      bucket_of, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _buckets, sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename BucketOf, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && __detail::bucket_function
+              <BucketOf, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const BucketOf bucket_of, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  std::allocator<std::byte> alloc;
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& index_of, const auto& key_of) {
+       __detail::indexed_bucket_sort_splice_data<_buckets, S&> data;
+       return __detail::indexed_bucket_sort_splice
+         (r, l, end, index_of,
+          __detail::project_predicate(comp, key_of, policy), data, policy);
+     }, policy, __detail::project_bucket_function(bucket_of, proj1), proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the open interval (left, right) in the given
+ *         range, with the bucket of every element computed directly
+ *         by the function bucket_of (see above for details), using a
+ *         custom allocator for additional memory. The sorting is
+ *         stable
+ * @tparam _buckets is the number of the buckets, i.e., bucket_of must
+ *         return a value less than _buckets for every element of the
+ *         interval
+ * @tparam BucketOf must be a monotone function (see above) from the
+ *         projected elements to bucket numbers
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ **/
+template <size_t _buckets, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename BucketOf, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && __detail::bucket_function
+              <BucketOf, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (Allocator&& alloc, R&& range, const L1 left, const L2 right,
+   const BucketOf bucket_of, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice<_buckets>(default_sort_policy{},
+                                      std::forward<Allocator>(alloc),
+                                      std::forward<R>(range), left, right,
+                                      bucket_of, proj1, comp, proj2);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _buckets, sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename BucketOf, typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_buckets > 0
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && splice_sortable_range<R, Comp, Proj2>
+           && __detail::bucket_function
+              <BucketOf, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (const Policy& policy, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const BucketOf bucket_of, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return __detail::sort_with_keys
+    (range, left, right, size_t(-1), alloc,
+     [&]<typename S>(S& r, const auto l, const auto end,
+                     const auto& index_of, const auto& key_of) {
+       auto data_ptr = __detail::allocate_sort_data
+         <__detail::indexed_bucket_sort_splice_data<_buckets, S&>>(alloc);
+       return __detail::indexed_bucket_sort_splice
+         (r, l, end, index_of,
+          __detail::project_predicate(comp, key_of, policy),
+          *data_ptr, policy);
+     }, policy, __detail::project_bucket_function(bucket_of, proj1), proj2);
+}
+
+/**
+ * @brief  Performs a splice-based version of the bucket sorting
+ *         algorithm on the given range, with the bucket of every
+ *         element computed directly by the function bucket_of (see
+ *         above for details). The sorting is stable
+ * @tparam _buckets is the number of the buckets, i.e., bucket_of must
+ *         return a value less than _buckets for every element of the
+ *         range
+ * @tparam BucketOf must be a monotone function (see above) from the
+ *         projected elements to bucket numbers
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _buckets,
+          spliceable_range R, typename BucketOf,
+          typename Proj1 = std::identity,
+          typename Comp = ranges::less, typename Proj2 = std::identity>
+  requires(_buckets > 0 && splice_sortable_range<R, Comp, Proj2>
+           && __detail::bucket_function
+              <BucketOf, std::projected<ranges::iterator_t<R>, Proj1>>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> bucket_sort_splice
+  (R&& range, const BucketOf bucket_of, const Proj1 proj1 = {},
+   const Comp comp = {}, const Proj2 proj2 = {}) {
+  return bucket_sort_splice<_buckets>(std::forward<R>(range),
+                                      before_begin(range), ranges::end(range),
+                                      bucket_of, proj1, comp, proj2);
+}
+
+/**
+ * @brief The concept of a range that can be sorted by splicing with
+ *        the radix sort, i.e., its elements are projected to
+ *        integral (non-bool) keys
+ **/
+template <typename R, typename Proj = std::identity>
+concept radix_sortable_range = spliceable_range<R>
+  && std::indirectly_regular_unary_invocable<Proj, ranges::iterator_t<R>>
+  && __detail::radix_key<std::remove_cvref_t
+                         <std::indirect_result_t<Proj&,
+                                                 ranges::iterator_t<R>>>>;
+
+/**
+ * @brief  Performs a splice-based version of the stable LSD radix
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range, ordering the elements by their integral keys
+ *
+ * Each pass distributes the elements into 2^_radix_bits buckets by
+ * the current digit of their keys. The buckets are kept in the range
+ * itself as consecutive subranges, so the elements are moved by
+ * splicing them after the last element of their bucket (and the
+ * consecutive elements with the same digit are spliced at once). The
+ * digits that are the same for all the keys are detected in advance
+ * and skipped. Thus, the algorithm requires at most (1 + number of
+ * digits) linear traversals and no comparisons, which makes it a
+ * good choice for long ranges with integral keys
+ *
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 12)
+ * @tparam Proj must project the elements to integral keys (signed
+ *         keys are ordered as usual, i.e., negative ones go first)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   The algorithm uses additional (2^_radix_bits *
+ *         (sizeof(iterator_t<R>) + 1/8)) bytes of memory on the
+ *         stack. If that is too much stack memory, consider using the
+ *         version that takes an allocator
+ **/
+template <size_t _radix_bits = 8,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 12
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> radix_sort_splice
+  (R&& range, const L1 left, const L2 right, const Proj proj = {}) {
+  return radix_sort_splice<_radix_bits>(default_sort_policy{},
+                                        std::forward<R>(range), left, right,
+                                        proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _radix_bits = 8, sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 12
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> radix_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const Proj proj = {}) {
+  __detail::radix_sort_splice_data<_radix_bits, R> data;
+  return __detail::radix_sort_splice(std::forward<R>(range), left, right,
+                                     __detail::project_radix_key(proj),
+                                     data, policy);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable LSD radix
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range (see above for details), using a custom
+ *         allocator for additional memory
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 12)
+ * @tparam Proj must project the elements to integral keys
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ **/
+template <size_t _radix_bits = 8, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 12
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> radix_sort_splice
+  (Allocator&& alloc, R&& range, const L1 left, const L2 right,
+   const Proj proj = {}) {
+  auto data_ptr = __detail::allocate_sort_data
+    <__detail::radix_sort_splice_data<_radix_bits, R>>
+    (std::forward<Allocator>(alloc));
+  return __detail::radix_sort_splice(std::forward<R>(range), left, right,
+                                     __detail::project_radix_key(proj),
+                                     *data_ptr, default_sort_policy{});
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable LSD radix
+ *         sorting algorithm on the given range (see above for
+ *         details)
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 12)
+ * @tparam Proj must project the elements to integral keys
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _radix_bits = 8,
+          spliceable_range R, typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 12
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> radix_sort_splice
+  (R&& range, const Proj proj = {}) {
+  return radix_sort_splice<_radix_bits>(std::forward<R>(range),
+                                        before_begin(range),
+                                        ranges::end(range), proj);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable LSD radix
+ *         sorting algorithm on the given range (see above for
+ *         details), using a custom allocator for additional memory
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 12)
+ * @tparam Proj must project the elements to integral keys
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _radix_bits = 8, typename Allocator,
+          spliceable_range R, typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 12
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>> radix_sort_splice
+  (Allocator&& alloc, R&& range, const Proj proj = {}) {
+  return radix_sort_splice<_radix_bits>(std::forward<Allocator>(alloc),
+                                        std::forward<R>(range),
+                                        before_begin(range),
+                                        ranges::end(range), proj);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable MSD radix
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range, ordering the elements by their integral keys
+ *
+ * The interval is distributed into 2^_radix_bits buckets by the
+ * highest digit of the keys (the same way as in radix_sort_splice),
+ * then every bucket is sorted recursively by the following digits.
+ * The buckets of at most 32 elements are sorted with the merge (or
+ * insertion) sort instead, and the digits that are the same for all
+ * the keys of an interval are skipped. Thus, unlike radix_sort_splice,
+ * the algorithm does not need to go through all the digits of wide
+ * keys if the elements can be told apart by the first ones
+ *
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 8)
+ * @tparam Proj must project the elements to integral keys (signed
+ *         keys are ordered as usual, i.e., negative ones go first)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   The algorithm uses additional (2^_radix_bits *
+ *         (sizeof(iterator_t<R>) + sizeof(size_t)) * (1 + number of
+ *         digits in the key)) bytes of memory on the stack (roughly).
+ *         If that is too much stack memory, consider using the
+ *         version that takes an allocator
+ **/
+template <size_t _radix_bits = 8,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 8
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+msd_radix_sort_splice
+  (R&& range, const L1 left, const L2 right, const Proj proj = {}) {
+  return msd_radix_sort_splice<_radix_bits>(default_sort_policy{},
+                                            std::forward<R>(range),
+                                            left, right, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _radix_bits = 8, sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 8
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+msd_radix_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const Proj proj = {}) {
+  __detail::msd_radix_sort_splice_data
+    <_radix_bits, R, __detail::radix_key_t<R, Proj>> data;
+  return __detail::msd_radix_sort_splice<_radix_bits>
+    (std::forward<R>(range), left, right, __detail::project_radix_key(proj),
+     data, policy);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable MSD radix
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range (see above for details), using a custom
+ *         allocator for additional memory
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 8)
+ * @tparam Proj must project the elements to integral keys
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ **/
+template <size_t _radix_bits = 8, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 8
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+msd_radix_sort_splice
+  (Allocator&& alloc, R&& range, const L1 left, const L2 right,
+   const Proj proj = {}) {
+  auto data_ptr = __detail::allocate_sort_data
+    <__detail::msd_radix_sort_splice_data
+     <_radix_bits, R, __detail::radix_key_t<R, Proj>>>
+    (std::forward<Allocator>(alloc));
+  return __detail::msd_radix_sort_splice<_radix_bits>
+    (std::forward<R>(range), left, right, __detail::project_radix_key(proj),
+     *data_ptr, default_sort_policy{});
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable MSD radix
+ *         sorting algorithm on the given range (see above for
+ *         details)
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 8)
+ * @tparam Proj must project the elements to integral keys
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _radix_bits = 8,
+          spliceable_range R, typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 8
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+msd_radix_sort_splice(R&& range, const Proj proj = {}) {
+  return msd_radix_sort_splice<_radix_bits>(std::forward<R>(range),
+                                            before_begin(range),
+                                            ranges::end(range), proj);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable MSD radix
+ *         sorting algorithm on the given range (see above for
+ *         details), using a custom allocator for additional memory
+ * @tparam _radix_bits is the number of bits in a digit (from 1 to 8)
+ * @tparam Proj must project the elements to integral keys
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _radix_bits = 8, typename Allocator,
+          spliceable_range R, typename Proj = std::identity>
+  requires(_radix_bits > 0 && _radix_bits <= 8
+           && __detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && radix_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+msd_radix_sort_splice(Allocator&& alloc, R&& range, const Proj proj = {}) {
+  return msd_radix_sort_splice<_radix_bits>(std::forward<Allocator>(alloc),
+                                            std::forward<R>(range),
+                                            before_begin(range),
+                                            ranges::end(range), proj);
+}
+
+/**
+ * @brief The concept of a range that can be sorted by splicing with
+ *        the counting sort, i.e., its elements are projected to
+ *        integral (non-bool) or enumeration keys
+ **/
+template <typename R, typename Proj = std::identity>
+concept counting_sortable_range = spliceable_range<R>
+  && std::indirectly_regular_unary_invocable<Proj, ranges::iterator_t<R>>
+  && __detail::counting_key<std::remove_cvref_t
+                            <std::indirect_result_t<Proj&,
+                                                    ranges::iterator_t<R>>>>;
+
+/**
+ * @brief  Performs a splice-based version of the stable counting
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range, ordering the elements by their keys from the
+ *         small domain [0, _domain)
+ *
+ * Every key value gets its own bucket, kept in the range itself as a
+ * consecutive subrange (like in radix_sort_splice), so the interval
+ * is sorted after a single distribution pass with no comparisons, in
+ * O(n + _domain) time. That makes it the best choice for the elements
+ * keyed by small enumerations or priority levels
+ *
+ * @tparam _domain is the number of the possible keys, i.e., every key
+ *         (converted to size_t) must be less than _domain
+ * @tparam Proj must project the elements to integral or enumeration
+ *         keys
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   The algorithm uses additional (_domain *
+ *         (sizeof(iterator_t<R>) + sizeof(size_t))) bytes of memory on
+ *         the stack
+ **/
+template <size_t _domain,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_domain > 0 && counting_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+counting_sort_splice
+  (R&& range, const L1 left, const L2 right, const Proj proj = {}) {
+  return counting_sort_splice<_domain>(default_sort_policy{},
+                                       std::forward<R>(range), left, right,
+                                       proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <size_t _domain, sort_policy Policy,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Proj = std::identity>
+  requires(_domain > 0 && counting_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+counting_sort_splice
+  (const Policy& policy, R&& range, const L1 left, const L2 right,
+   const Proj proj = {}) {
+  __detail::indexed_bucket_sort_splice_data<_domain, R> data;
+  return __detail::counting_sort_splice(std::forward<R>(range), left, right,
+                                        __detail::project_counting_key(proj),
+                                        data, policy);
+}
+
+/**
+ * @brief  Performs a splice-based version of the stable counting
+ *         sorting algorithm on the given range, ordering the elements
+ *         by their keys from the small domain [0, _domain) (see above
+ *         for details)
+ * @tparam _domain is the number of the possible keys, i.e., every key
+ *         (converted to size_t) must be less than _domain
+ * @tparam Proj must project the elements to integral or enumeration
+ *         keys
+ * @return The size of the range and an iterator to its last element
+ *         after sorting (or begin(range) if it is empty)
+ **/
+template <size_t _domain, spliceable_range R, typename Proj = std::identity>
+  requires(_domain > 0 && counting_sortable_range<R, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+counting_sort_splice(R&& range, const Proj proj = {}) {
+  return counting_sort_splice<_domain>(std::forward<R>(range),
+                                       before_begin(range),
+                                       ranges::end(range), proj);
+}
+
+/**
+ * @brief The concept of a range that can be sorted by splicing with the
+ *        buffered sort, i.e., it is splice-sortable and the keys of
+ *        its elements can be stored in a buffer (either by value or by
+ *        address, see buffered_sort_splice)
+ **/
+template <typename R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+concept buffer_sortable_range = splice_sortable_range<R, Comp, Proj>
+  && __detail::bufferable_sort_key<__detail::sort_key_t<R, Proj>>;
+
+/**
+ * @brief  Performs a buffered splice-based version of the stable
+ *         sorting algorithm on the open interval (left, right) in the
+ *         given range, using a custom allocator for additional memory
+ *
+ * The keys of the elements (i.e., the results of the projection) are
+ * gathered into a contiguous buffer in one traversal, together with
+ * their original positions. The buffer is then sorted with the
+ * standard sort (using the positions to break the ties, thus keeping
+ * the sorting stable), and the elements are relinked in the sorted
+ * order in one more pass. Thus, the nodes of the range are only
+ * accessed twice, which pays off for long ranges scattered in memory
+ * (see prefers_buffered_sort)
+ *
+ * The small trivially copyable keys are copied into the buffer, the
+ * others are stored by address if the projection returns a reference
+ * (and by value otherwise)
+ *
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @param  left must be a valid left limit of the given range (i.e., a
+ *         front sentinel or a dereferenceable iterator)
+ * @param  right must be a valid right limit of the given range (i.e.,
+ *         a sentinel equal to end(range) or a dereferenceable
+ *         iterator)
+ * @return The size of the sorted interval and an iterator to its last
+ *         element after sorting (or after(range, left) if the
+ *         interval is empty)
+ * @note   The algorithm uses O(n) additional memory (from the
+ *         allocator) for the interval of n elements. If an exception
+ *         is thrown by the comparator or the allocator, the range is
+ *         left unchanged
+ **/
+template <typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && buffer_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+buffered_sort_splice
+  (Allocator&& alloc, R&& range, const L1 left, const L2 right,
+   const Comp comp = {}, const Proj proj = {}) {
+  return buffered_sort_splice(default_sort_policy{},
+                              std::forward<Allocator>(alloc),
+                              std::forward<R>(range), left, right,
+                              comp, proj);
+}
+
+/**
+ * @brief Same as the above, but uses the given sort policy
+ **/
+template <sort_policy Policy, typename Allocator,
+          spliceable_range R, left_limit_of<R> L1, right_limit_of<R> L2,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && buffer_sortable_range<R, Comp, Proj>)
+constexpr std::pair<size_t, ranges::borrowed_iterator_t<R>>
+buffered_sort_splice
+  (const Policy& policy, Allocator&& alloc,
+   R&& range, const L1 left, const L2 right,
+   const Comp comp = {}, const Proj proj = {}) {
+  return __detail::buffered_sort_splice(std::forward<R>(range), left, right,
+                                        alloc, comp, proj, policy);
+}
+
+/**
+ * @brief  Performs a buffered splice-based version of the stable
+ *         sorting algorithm on the given range (see above for
+ *         details), using a custom allocator for additional memory
+ * @tparam Comp must be a strict weak order (see splice_sortable_range)
+ * @return An iterator to the last element of the range (or equal to
+ *         end(range) if the range is empty)
+ **/
+template <typename Allocator, spliceable_range R,
+          typename Comp = ranges::less, typename Proj = std::identity>
+  requires(__detail::allocator_like<std::remove_cvref_t<Allocator>>
+           && buffer_sortable_range<R, Comp, Proj>)
+constexpr ranges::borrowed_iterator_t<R> buffered_sort_splice
+  (Allocator&& alloc, R&& range, const Comp comp = {}, const Proj proj = {}) {
+  return buffered_sort_splice(std::forward<Allocator>(alloc),
+                              std::forward<R>(range),
+                              before_begin(range), ranges::end(range),
+                              comp, proj).second;
+}
+
+/**
+ * @brief  Tells whether the buffered sort (see buffered_sort_splice)
+ *         is expected to be faster than the in-place algorithms (like
+ *         merge_sort_splice) for size elements of the given range
+ *
+ * The buffered sort pays off when the keys are small and trivially
+ * copyable, so that the sorting of the buffer does not touch the
+ * nodes, and the number of elements is at least
+ * Policy::buffered_sort_min_size, so that the traversals saved make up
+ * for the allocation
+ **/
+template <sort_policy Policy = default_sort_policy,
+          spliceable_range R, typename Proj = std::identity>
+  requires(std::indirectly_regular_unary_invocable<Proj,
+                                                   ranges::iterator_t<R>>)
+constexpr bool prefers_buffered_sort
+  (R&&, const size_t size, const Proj& = {}) noexcept {
+  return __detail::cheap_sort_key<__detail::sort_key_t<R, Proj>>
+    && size >= Policy::buffered_sort_min_size;
+}
+
 } // namespace enranged
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <forward_list>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "enranged/parallel_sorting.hpp"
+
+#include "linked_list.hpp"
+
+using namespace enranged;
+
+// Our test list only modifies the front when splicing after the front
+// sentinel, so it can be spliced concurrently
+template <typename T, typename Allocator>
+constexpr bool enranged::enable_concurrent_splicing<linked_list<T, Allocator>> =
+  true;
+
+struct stable_type {
+  int value;
+  size_t count;
+
+  bool operator==(const stable_type&) const noexcept = default;
+};
+
+// Runs every task in a new thread (or in place), the threads are
+// joined on destruction
+class test_executor {
+public:
+  test_executor(const size_t concurrency, const bool in_place = false):
+    concurrency_(concurrency), in_place_(in_place) {}
+
+  void execute(std::function<void()> task) {
+    ++executed;
+    if (in_place_)
+      task();
+    else
+      threads_.emplace_back(std::move(task));
+  }
+
+  size_t max_concurrency() const noexcept {
+    return concurrency_;
+  }
+
+  size_t executed = 0;
+
+private:
+  size_t concurrency_;
+  bool in_place_;
+  std::vector<std::jthread> threads_;
+};
+
+struct small_chunks_policy: default_sort_policy {
+  constexpr static size_t parallel_min_chunk = 16;
+};
+
+template <typename T>
+class ParallelSortingTests: public ::testing::Test {
+protected:
+  void build(const size_t size, const int modulo) {
+    test_vec.resize(size);
+    size_t ctr = 0;
+    ranges::generate(test_vec, [&ctr, modulo]() {
+      return stable_type{int(rand() % modulo), ++ctr};
+    });
+
+    range = T(test_vec.begin(), test_vec.end());
+  }
+
+  // Calls the sorter with the limits skipping the given number of
+  // elements on both sides, and checks the result
+  template <typename F>
+  void test(const size_t skip_left, const size_t skip_right,
+            const F sorter) {
+    const size_t size = test_vec.size() - skip_left - skip_right;
+    const auto right =
+      ranges::next(ranges::begin(range), skip_left + size);
+
+    ranges::iterator_t<T> last;
+    if (skip_left == 0)
+      last = sorter(before_begin(range), right, size);
+    else
+      last = sorter(ranges::next(ranges::begin(range), skip_left - 1),
+                    right, size);
+
+    const auto test_begin = test_vec.begin() + skip_left;
+    const auto test_end = test_vec.end() - skip_right;
+    ranges::stable_sort(test_begin, test_end, {}, &stable_type::value);
+
+    if (size > 0) {
+      EXPECT_EQ(*last, *ranges::prev(test_end));
+    }
+
+    auto it = ranges::begin(range);
+    for (const auto& val : test_vec) { ASSERT_EQ(*it++, val); }
+  }
+
+  T range;
+  std::vector<stable_type> test_vec;
+};
+
+using ConcurrentlySpliceSortable =
+  ::testing::Types<std::forward_list<stable_type>, linked_list<stable_type>>;
+TYPED_TEST_SUITE(ParallelSortingTests, ConcurrentlySpliceSortable);
+
+TYPED_TEST(ParallelSortingTests, merge_sort_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 3000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    this->build(1 + rand() % MaxElts, i % 2 ? 16 : 1 << 20);
+
+    const size_t skip_left = std::min<size_t>(rand() % 4,
+                                              this->test_vec.size());
+    const size_t skip_right =
+      std::min<size_t>(rand() % 4, this->test_vec.size() - skip_left);
+
+    test_executor executor(1 + i % 9, i % 5 == 0);
+    this->test(skip_left, skip_right,
+               [&](const auto left, const auto, const size_t size) {
+      return merge_sort_splice(small_chunks_policy{}, executor,
+                               this->range, left, size,
+                               {}, &stable_type::value);
+    });
+
+    if (executor.max_concurrency() > 1
+        && this->test_vec.size() - skip_left - skip_right >= 64) {
+      EXPECT_GT(executor.executed, 0);
+    }
+  }
+}
+
+TYPED_TEST(ParallelSortingTests, bucket_sort_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 3000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    this->build(1 + rand() % MaxElts, i % 2 ? 64 : 1 << 20);
+    const int shift = i % 2 ? 2 + rand() % 3 : 14 + rand() % 4;
+    const auto eq_rel = [shift](const int x, const int y) {
+      return x >> shift == y >> shift;
+    };
+
+    const size_t skip_left = std::min<size_t>(rand() % 4,
+                                              this->test_vec.size());
+    const size_t skip_right =
+      std::min<size_t>(rand() % 4, this->test_vec.size() - skip_left);
+
+    test_executor executor(1 + i % 9, i % 5 == 0);
+    this->test(skip_left, skip_right,
+               [&](const auto left, const auto right, const size_t size) {
+      const auto [out_size, last] =
+        bucket_sort_splice<8>(small_chunks_policy{}, executor,
+                              this->range, left, right,
+                              eq_rel, &stable_type::value,
+                              {}, &stable_type::value);
+      EXPECT_EQ(out_size, size);
+      return last;
+    });
+  }
+}
+
+TYPED_TEST(ParallelSortingTests, exceptions) {
+  constexpr size_t Elts = 1000;
+  this->build(Elts, 1 << 20);
+
+  test_executor executor(4);
+  std::atomic<size_t> calls = 0;
+  EXPECT_THROW(merge_sort_splice(small_chunks_policy{}, executor,
+                                 this->range, before_begin(this->range),
+                                 Elts, [&calls](const auto&, const auto&) {
+                                   if (++calls > 100) throw 42;
+                                   return false;
+                                 }), int);
+
+  // Nothing should be lost in the process
+  EXPECT_EQ(ranges::distance(this->range), Elts);
+}
+
+#if __cpp_lib_execution
+
+TEST(ParallelSortingExecutionTests, execution_policies) {
+  constexpr size_t Elts = 100000;
+
+  std::mt19937 gen{unsigned(rand())};
+  std::vector<int> test_vec(Elts);
+  ranges::generate(test_vec, [&gen]() {
+    return std::uniform_int_distribution{}(gen);
+  });
+
+  for (size_t i = 0; i < 4; ++i) {
+    std::forward_list<int> list(test_vec.begin(), test_vec.end());
+
+    std::forward_list<int>::iterator last;
+    switch (i) {
+    case 0:
+      last = merge_sort_splice(std::execution::seq, list,
+                               list.before_begin(), Elts);
+      break;
+    case 1:
+      last = merge_sort_splice(std::execution::par, list,
+                               list.before_begin(), Elts);
+      break;
+    case 2:
+      last = bucket_sort_splice(std::execution::seq, list,
+                                list.before_begin(), list.end(),
+                                [](const int x, const int y) {
+                                  return x >> 26 == y >> 26;
+                                }).second;
+      break;
+    default:
+      last = bucket_sort_splice(std::execution::par_unseq, list,
+                                list.before_begin(), list.end(),
+                                [](const int x, const int y) {
+                                  return x >> 26 == y >> 26;
+                                }).second;
+    }
+
+    EXPECT_TRUE(ranges::is_sorted(list));
+    EXPECT_EQ(*last, ranges::max(test_vec));
+  }
+}
+
+#endif
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <array>
+#include <compare>
 #include <cstdint>
 #include <forward_list>
 #include <gtest/gtest.h>
@@ -6,6 +8,8 @@
 #include <list>
 #include <memory>
 #include <random>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -148,6 +152,409 @@ TYPED_TEST(SortingTests, coinplace_merge_splice) {
   }
 }
 
+TYPED_TEST(SortingTests, merge_splice) {
+  constexpr size_t Runs = 100;
+  constexpr size_t MaxSources = 20;
+  constexpr size_t MaxElts = 300;
+
+  using value_t = typename TypeParam::value_type;
+  const auto sort = [](const auto first, const auto last) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      ranges::stable_sort(first, last, std::greater{}, &test_type::value);
+    else
+      ranges::sort(first, last);
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    // The first piece goes to dst, the rest are the sources. Some of
+    // them are empty, and some only have a few elements
+    std::vector<size_t> sizes(1 + rand() % (i == 0 ? 1 : MaxSources));
+    ranges::generate(sizes, [i]() {
+      return i % 3 == 0 ? rand() % 4 : rand() % MaxElts;
+    });
+
+    size_t total = 0;
+    for (const auto size : sizes) total+= size;
+    this->build_test_vec(total);
+
+    std::vector<TypeParam> srcs;
+    auto piece_begin = this->test_vec.begin();
+    for (size_t s = 0; s < sizes.size(); ++s) {
+      const auto piece_end = piece_begin + sizes[s];
+      sort(piece_begin, piece_end);
+
+      TypeParam piece(sizes[s]);
+      ranges::copy(piece_begin, piece_end, ranges::begin(piece));
+      if (s == 0) this->range = std::move(piece);
+      else srcs.push_back(std::move(piece));
+
+      piece_begin = piece_end;
+    }
+
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      merge_splice(this->range, srcs, std::greater{}, &test_type::value);
+    else if (i % 2)
+      merge_splice(this->range, srcs);
+    else
+      merge_splice(prefetching_sort_policy<>{}, this->range, srcs);
+
+    // The merge is stable, so the result is the same as after the
+    // stable sorting of the concatenation
+    std::vector<value_t> expected = this->test_vec;
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      ranges::stable_sort(expected, std::greater{}, &test_type::value);
+    else
+      ranges::stable_sort(expected);
+
+    ASSERT_TRUE(ranges::equal(this->range, expected));
+    // NB: linked_list doesn't update its size when spliced with
+    // another list
+    for (auto& src : srcs) { EXPECT_EQ(ranges::begin(src), ranges::end(src)); }
+  }
+}
+
+TYPED_TEST(SortingTests, merge_splice_intervals) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 500;
+
+  using value_t = typename TypeParam::value_type;
+  const auto sort = [](const auto first, const auto last) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      ranges::stable_sort(first, last, std::greater{}, &test_type::value);
+    else
+      ranges::sort(first, last);
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    // Either of the intervals may be empty or have a few elements
+    const auto random_size = [i](const size_t mode) {
+      return i % 4 == mode ? rand() % 3 : rand() % MaxElts;
+    };
+    const size_t dst_size = random_size(1), src_size = random_size(2);
+    const size_t dst_skip_left = rand() % 4, dst_skip_right = rand() % 4;
+    const size_t src_skip_left = rand() % 4, src_skip_right = rand() % 4;
+
+    this->build_test_vec(dst_skip_left + dst_size + dst_skip_right
+                         + src_skip_left + src_size + src_skip_right);
+
+    const auto dst_begin = this->test_vec.begin() + dst_skip_left;
+    const auto dst_end = dst_begin + dst_size;
+    const auto src_vec_begin = dst_end + dst_skip_right;
+    const auto src_begin = src_vec_begin + src_skip_left;
+    const auto src_end = src_begin + src_size;
+    sort(dst_begin, dst_end);
+    sort(src_begin, src_end);
+
+    this->range = TypeParam(src_vec_begin - this->test_vec.begin());
+    ranges::copy(this->test_vec.begin(), src_vec_begin,
+                 ranges::begin(this->range));
+    TypeParam src(this->test_vec.end() - src_vec_begin);
+    ranges::copy(src_vec_begin, this->test_vec.end(), ranges::begin(src));
+
+    const auto last =
+      invoke_with_limits(this->range, dst_skip_left, dst_size,
+                         dst_skip_right,
+                         [&](const auto dst_left, const auto dst_right) {
+        return invoke_with_limits(src, src_skip_left, src_size,
+                                  src_skip_right,
+                                  [&](const auto src_left,
+                                      const auto src_right) {
+          if constexpr (SortingTests<TypeParam>::is_stability_test)
+            return merge_splice(this->range, dst_left, dst_right,
+                                src, src_left, src_right,
+                                std::greater{}, &test_type::value);
+          else if (i % 2)
+            return merge_splice(this->range, dst_left, dst_right,
+                                src, src_left, src_right);
+          else
+            return merge_splice(prefetching_sort_policy<>{},
+                                this->range, dst_left, dst_right,
+                                src, src_left, src_right);
+        });
+      });
+
+    // The merge is stable, so the result is the same as after the
+    // stable sorting of the concatenation
+    std::vector<value_t> merged(dst_begin, dst_end);
+    merged.insert(merged.end(), src_begin, src_end);
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      ranges::stable_sort(merged, std::greater{}, &test_type::value);
+    else
+      ranges::stable_sort(merged);
+
+    std::vector<value_t> expected(this->test_vec.begin(), dst_begin);
+    expected.insert(expected.end(), merged.begin(), merged.end());
+    expected.insert(expected.end(), dst_end, src_vec_begin);
+    ASSERT_TRUE(ranges::equal(this->range, expected));
+
+    std::vector<value_t> expected_src(src_vec_begin, src_begin);
+    expected_src.insert(expected_src.end(), src_end, this->test_vec.end());
+    ASSERT_TRUE(ranges::equal(src, expected_src));
+
+    EXPECT_EQ(last, ranges::next(ranges::begin(this->range),
+                                 dst_skip_left + merged.size()
+                                 - !merged.empty()));
+  }
+}
+
+TYPED_TEST(SortingTests, unique_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+
+  using value_t = typename TypeParam::value_type;
+  const auto key = [](const value_t& x) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      return x.value;
+    else
+      return x;
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto test_begin = this->test_vec.begin() + skip_left;
+    const auto test_end = test_begin + size;
+
+    // Make runs of duplicates of various lengths
+    if constexpr (!SortingTests<TypeParam>::is_stability_test) {
+      const int distinct = 1 + rand() % (i % 2 ? 10 : 1000);
+      for (auto& x : this->test_vec) x%= distinct;
+    }
+    ranges::sort(test_begin, test_end, {}, key);
+    this->build_range();
+
+    TypeParam discard(i % 3);
+    ranges::fill(discard, this->test_vec.front());
+    const std::vector<value_t> discard_tail(ranges::begin(discard),
+                                            ranges::end(discard));
+
+    const auto removed =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return unique_splice(this->range, left, right, discard,
+                               {}, &test_type::value);
+        else
+          return unique_splice(this->range, left, right, discard);
+      });
+
+    std::vector<value_t> expected(this->test_vec.begin(), test_begin);
+    std::vector<value_t> expected_discard;
+    for (auto it = test_begin; it != test_end; ++it) {
+      if (it != test_begin && key(*it) == key(expected.back()))
+        expected_discard.push_back(*it);
+      else
+        expected.push_back(*it);
+    }
+    expected.insert(expected.end(), test_end, this->test_vec.end());
+    expected_discard.insert(expected_discard.end(),
+                            discard_tail.begin(), discard_tail.end());
+
+    EXPECT_EQ(removed, size + skip_left + skip_right - expected.size());
+    ASSERT_TRUE(ranges::equal(this->range, expected));
+    ASSERT_TRUE(ranges::equal(discard, expected_discard));
+  }
+}
+
+TYPED_TEST(SortingTests, set_operations) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 500;
+
+  using value_t = typename TypeParam::value_type;
+  const auto key = [](const value_t& x) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      return -x.value;  // Sorted with std::greater
+    else
+      return x;
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    const size_t size1 = i % 5 == 0 ? rand() % 4 : rand() % MaxElts;
+    const size_t size2 = i % 7 == 0 ? rand() % 4 : rand() % MaxElts;
+    this->build_test_vec(size1 + size2);
+
+    // Make sure there are plenty of matches
+    if constexpr (!SortingTests<TypeParam>::is_stability_test) {
+      const int distinct = 1 + rand() % (i % 2 ? 10 : 1000);
+      for (auto& x : this->test_vec) x%= distinct;
+    }
+
+    const auto mid = this->test_vec.begin() + size1;
+    ranges::sort(this->test_vec.begin(), mid, {}, key);
+    ranges::sort(mid, this->test_vec.end(), {}, key);
+
+    this->range = TypeParam(size1);
+    ranges::copy(this->test_vec.begin(), mid, ranges::begin(this->range));
+    TypeParam second(size2);
+    ranges::copy(mid, this->test_vec.end(), ranges::begin(second));
+
+    TypeParam leftover(i % 3);
+    ranges::fill(leftover, this->test_vec.empty() ? value_t{}
+                                                  : this->test_vec.front());
+    const std::vector<value_t> leftover_tail(ranges::begin(leftover),
+                                             ranges::end(leftover));
+
+    const auto call = [&](const auto set_op, const auto std_set_op) {
+      std::vector<value_t> expected;
+      std_set_op(this->test_vec.begin(), mid, mid, this->test_vec.end(),
+                 std::back_inserter(expected), ranges::less{}, key, key);
+      // Every other four runs (one of each operation) use the
+      // equivalent three-way comparator
+      if constexpr (SortingTests<TypeParam>::is_stability_test) {
+        if (i % 8 < 4)
+          set_op(this->range, second, leftover,
+                 std::greater{}, &test_type::value);
+        else
+          set_op(this->range, second, leftover,
+                 [](const int x, const int y) { return y <=> x; },
+                 &test_type::value);
+      }
+      else if (i % 8 < 4)
+        set_op(this->range, second, leftover);
+      else
+        set_op(this->range, second, leftover, std::compare_three_way{});
+      return expected;
+    };
+
+    std::vector<value_t> expected;
+    switch (i % 4) {
+    case 0:
+      expected = call([](auto&&... args) { set_union_splice(args...); },
+                      ranges::set_union);
+      break;
+    case 1:
+      expected =
+        call([](auto&&... args) { set_intersection_splice(args...); },
+             ranges::set_intersection);
+      break;
+    case 2:
+      expected = call([](auto&&... args) { set_difference_splice(args...); },
+                      ranges::set_difference);
+      break;
+    default:
+      expected =
+        call([](auto&&... args) { set_symmetric_difference_splice(args...); },
+             ranges::set_symmetric_difference);
+    }
+
+    ASSERT_TRUE(ranges::equal(this->range, expected));
+    // NB: linked_list doesn't update its size when spliced with
+    // another list
+    EXPECT_EQ(ranges::begin(second), ranges::end(second));
+
+    // Nothing is lost: the rest of the elements are put to the front
+    // of leftover in the sorted order
+    std::vector<value_t> dropped(ranges::begin(leftover),
+                                 ranges::end(leftover));
+    ASSERT_EQ(dropped.size() + expected.size(),
+              size1 + size2 + leftover_tail.size());
+    const auto tail_begin = dropped.end() - leftover_tail.size();
+    ASSERT_TRUE(ranges::equal(tail_begin, dropped.end(),
+                              leftover_tail.begin(), leftover_tail.end()));
+    dropped.erase(tail_begin, dropped.end());
+    EXPECT_TRUE(ranges::is_sorted(dropped, {}, key));
+
+    if constexpr (SortingTests<TypeParam>::is_stability_test) {
+      // The equivalent elements are dropped in their merged order,
+      // i.e., the ones of first go before the ones of second
+      std::vector<value_t> merged;
+      ranges::merge(this->test_vec.begin(), mid, mid, this->test_vec.end(),
+                    std::back_inserter(merged), std::greater{},
+                    &test_type::value, &test_type::value);
+      std::erase_if(merged, [&expected](const value_t& x) {
+        return ranges::find(expected, x) != expected.end();
+      });
+      ASSERT_EQ(dropped, merged);
+    }
+
+    std::vector<value_t> all = std::move(dropped);
+    all.insert(all.end(), expected.begin(), expected.end());
+    const auto total_order = [&key](const value_t& x, const value_t& y) {
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        return std::tie(x.value, x.count) < std::tie(y.value, y.count);
+      else
+        return x < y;
+    };
+    ranges::sort(all, total_order);
+    ranges::sort(this->test_vec, total_order);
+    ASSERT_EQ(all, this->test_vec);
+  }
+}
+
+TYPED_TEST(SortingTests, group_by_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+
+  using value_t = typename TypeParam::value_type;
+  const auto key = [](const value_t& x) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      return x.value;
+    else
+      return x;
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto test_begin = this->test_vec.begin() + skip_left;
+    const auto test_end = test_begin + size;
+
+    if constexpr (!SortingTests<TypeParam>::is_stability_test) {
+      const int distinct = 1 + rand() % (i % 2 ? 10 : 1000);
+      for (auto& x : this->test_vec) x%= distinct;
+    }
+    // Some runs of equal keys
+    if (i % 3 == 0) ranges::sort(test_begin, test_begin + size / 2, {}, key);
+    this->build_range();
+
+    const auto groups =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        // A bad hash makes every lookup collide
+        const auto bad_hash = [](const int) { return size_t(42); };
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return group_by_splice(this->range, left, right,
+                                 &test_type::value);
+        else if (i % 4 == 1)
+          return group_by_splice(this->range, left, right,
+                                 {}, bad_hash);
+        else if (i % 4 == 2)
+          return group_by_splice(std::allocator<int>{}, this->range,
+                                 left, right);
+        else
+          return group_by_splice(this->range, left, right);
+      });
+
+    // The groups go in the order of their first elements, the
+    // elements keep their order inside the groups
+    std::vector<value_t> expected(this->test_vec.begin(), test_begin);
+    std::vector<int> keys;
+    for (auto it = test_begin; it != test_end; ++it) {
+      if (ranges::find(keys, key(*it)) != keys.end()) continue;
+      keys.push_back(key(*it));
+      for (auto jt = it; jt != test_end; ++jt)
+        if (key(*jt) == key(*it)) expected.push_back(*jt);
+    }
+    expected.insert(expected.end(), test_end, this->test_vec.end());
+
+    ASSERT_TRUE(ranges::equal(this->range, expected));
+    ASSERT_EQ(groups.size(), keys.size());
+
+    auto it = ranges::next(ranges::begin(this->range), skip_left);
+    for (size_t g = 0; g < groups.size(); ++g) {
+      const auto [group_size, group_last] = groups[g];
+      for (size_t j = 0; j < group_size; ++j, ++it) {
+        ASSERT_EQ(key(*it), keys[g]);
+      }
+      ASSERT_EQ(ranges::next(group_last), it);
+    }
+  }
+}
+
 TYPED_TEST(SortingTests, insertion_sort_splice) {
   constexpr size_t Runs = 100;
   constexpr size_t MaxElts = 1000;
@@ -156,170 +563,1220 @@ TYPED_TEST(SortingTests, insertion_sort_splice) {
     auto [skip_left, skip_right] =
       this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
 
-    ranges::iterator_t<TypeParam> result;
-    if (skip_left == 0) {
-      const auto count = this->test_vec.size() - skip_right;
-      if constexpr (SortingTests<TypeParam>::is_stability_test)
-        result =
-          insertion_sort_splice(this->range, before_begin(this->range), count,
-                                std::greater{}, &test_type::value);
-      else
-        result =
-          insertion_sort_splice(this->range, before_begin(this->range), count);
-    }
-    else {
-      const auto left = ranges::next(ranges::begin(this->range), skip_left - 1);
-      const auto count = this->test_vec.size() - skip_left - skip_right;
-      if constexpr (SortingTests<TypeParam>::is_stability_test)
-        result = insertion_sort_splice(this->range, left, count,
-                                       std::greater{}, &test_type::value);
-      else
-        result = insertion_sort_splice(this->range, left, count);
-    }
+    ranges::iterator_t<TypeParam> result;
+    if (skip_left == 0) {
+      const auto count = this->test_vec.size() - skip_right;
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        result =
+          insertion_sort_splice(this->range, before_begin(this->range), count,
+                                std::greater{}, &test_type::value);
+      else
+        result =
+          insertion_sort_splice(this->range, before_begin(this->range), count);
+    }
+    else {
+      const auto left = ranges::next(ranges::begin(this->range), skip_left - 1);
+      const auto count = this->test_vec.size() - skip_left - skip_right;
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        result = insertion_sort_splice(this->range, left, count,
+                                       std::greater{}, &test_type::value);
+      else
+        result = insertion_sort_splice(this->range, left, count);
+    }
+
+    this->test_sorted(result, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, merge_sort_splice) {
+  constexpr size_t Runs = 100;
+  constexpr size_t MaxElts = 1000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    ranges::iterator_t<TypeParam> result;
+    if (skip_left == 0) {
+      const auto count = this->test_vec.size() - skip_right;
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        result =
+          merge_sort_splice(this->range, before_begin(this->range), count,
+                            std::greater{}, &test_type::value);
+      else
+        result =
+          merge_sort_splice(this->range, before_begin(this->range), count);
+    }
+    else {
+      const auto left = ranges::next(ranges::begin(this->range), skip_left - 1);
+      const auto count = this->test_vec.size() - skip_left - skip_right;
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        result = merge_sort_splice(this->range, left, count,
+                                   std::greater{}, &test_type::value);
+      else
+        result = merge_sort_splice(this->range, left, count);
+    }
+
+    this->test_sorted(result, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, quick_sort_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 2000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto test_begin = this->test_vec.begin() + skip_left;
+    const auto test_end = test_begin + size;
+
+    // Partitioning only happens with many equivalent elements, so make
+    // sure there are some, and also try the sorted input
+    if constexpr (!SortingTests<TypeParam>::is_stability_test) {
+      if (i % 3 > 0) {
+        const int distinct = 1 + rand() % 40;
+        for (auto& x : this->test_vec) x%= distinct;
+      }
+      if (i % 5 == 1) ranges::sort(test_begin, test_end);
+    }
+    this->build_range();
+
+    const auto last =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [this, size, i](const auto left, const auto) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return quick_sort_splice(this->range, left, size,
+                                   std::greater{}, &test_type::value);
+        else if (i % 2)
+          return quick_sort_splice(this->range, left, size);
+        else
+          return quick_sort_splice(prefetching_sort_policy<>{},
+                                   this->range, left, size);
+      });
+
+    this->test_sorted(last, test_begin, test_end);
+  }
+}
+
+TEST(FlatListTests, ranked) {
+  // Test an internal structure used in sorting
+  constexpr size_t MaxElts = 300;
+
+  __detail::flat_ranked_list<size_t, MaxElts> list;
+  std::vector<size_t> test_vec;
+
+  static_assert(ranges::forward_range<decltype(list)>);
+  ASSERT_EQ(sizeof(decltype(list)::pos_t), 2);
+  ASSERT_EQ(sizeof(__detail::flat_ranked_list<size_t, 100>::pos_t), 1);
+
+  for (size_t i = 0; i < MaxElts; ++i) {
+    EXPECT_EQ(list.size(), i);
+
+    const auto des = rand() % 3;
+    const auto pos = des == 0 ? 0 : (des == 1 ? i : (rand() % (i + 1)));
+    const auto it = pos == 0
+      ? list.emplace_after(list.before_begin(), i)
+      : list.emplace_after(list.nth(pos - 1), i);
+
+    EXPECT_EQ(*it, i);
+    EXPECT_EQ(it.rank(), pos);
+    EXPECT_EQ(ranges::next(list.before_begin()), list.begin());
+    EXPECT_EQ(list.nth(list.size()), list.end());
+
+    test_vec.insert(test_vec.begin() + pos, i);
+    ASSERT_TRUE(ranges::equal(list, test_vec));
+    for (size_t r = 0; r <= i; ++r) { ASSERT_EQ(*list.nth(r), test_vec[r]); }
+  }
+
+  list.clear();
+  EXPECT_EQ(list.size(), 0);
+  EXPECT_EQ(list.begin(), list.end());
+
+  list.emplace_after(list.before_begin(), size_t{42});
+  EXPECT_EQ(ranges::distance(list), 1);
+  EXPECT_EQ(*list.begin(), 42);
+}
+
+template <size_t _shift>
+bool equal_shifts(const int x, const int y) noexcept {
+  return x >> _shift == y >> _shift;
+}
+
+// Calls the invoker with the left and right limits of the interval
+// that skips the given numbers of elements on both sides
+template <typename T, typename F>
+auto invoke_with_limits(T& range, const size_t skip_left,
+                        const size_t size, const size_t skip_right,
+                        const F invoker) {
+  if (skip_left == 0) {
+    if (skip_right == 0)
+      return invoker(before_begin(range), ranges::end(range));
+    else
+      return invoker(before_begin(range),
+                     ranges::next(ranges::begin(range), skip_left + size));
+  }
+  else {
+    const auto llim = ranges::next(ranges::begin(range), skip_left - 1);
+    if (skip_right == 0)
+      return invoker(llim, ranges::end(range));
+    else
+      return invoker(llim,
+                     ranges::next(ranges::begin(range), skip_left + size));
+  }
+}
+
+template <typename T, size_t _max_buckets = 1, size_t _shift = 0>
+auto call_bs(T& range, const size_t skip_left,
+             const size_t size, const size_t skip_right) {
+  return invoke_with_limits(range, skip_left, size, skip_right,
+                            [&range](const auto left, const auto right) {
+    if constexpr (SortingTests<T>::is_stability_test)
+      return bucket_sort_splice<_max_buckets>
+        (range, left, right, equal_shifts<_shift>, &test_type::value,
+         std::greater{}, &test_type::value);
+    else
+      return bucket_sort_splice<_max_buckets>(range, left, right,
+                                              equal_shifts<_shift>);
+  });
+}
+
+TYPED_TEST(SortingTests, bucket_sort_splice) {
+  constexpr size_t Runs = 500;
+  constexpr size_t MaxElts = 1000;
+
+  std::vector<decltype(&call_bs<TypeParam>)> sorters;
+  if constexpr (SortingTests<TypeParam>::is_stability_test)
+    sorters = {
+      &call_bs<TypeParam, 4, 1>, // exact match
+      &call_bs<TypeParam, 2, 1>, // less buckets
+      &call_bs<TypeParam, 8, 1>, // too many buckets
+      &call_bs<TypeParam, 3, 3>, // all equiv
+      &call_bs<TypeParam, 8, 0>  // all not equiv
+    };
+  else
+    sorters =  {
+      &call_bs<TypeParam, 32, 26>, // exact match
+      &call_bs<TypeParam, 20, 25>, // less buckets
+      &call_bs<TypeParam, 64, 27>, // too many buckets
+      &call_bs<TypeParam, 16, 31>, // all equiv
+      &call_bs<TypeParam, 8, 0>    // all not equiv
+    };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      sorters[rand() % sorters.size()](this->range,
+                                       skip_left, size, skip_right);
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, bucket_sort_splice_runtime_buckets) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+
+  // Both sides of the inline storage limit, with (many) more classes
+  // than buckets for most of them
+  constexpr size_t BucketCounts[] = { 0, 1, 7, 32, 33, 100, 5000 };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const size_t max_buckets = BucketCounts[i % std::size(BucketCounts)];
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return bucket_sort_splice(max_buckets, std::allocator<int>{},
+                                    this->range, left, right,
+                                    equal_shifts<1>, &test_type::value,
+                                    std::greater{}, &test_type::value);
+        else
+          return bucket_sort_splice(max_buckets, std::allocator<int>{},
+                                    this->range, left, right,
+                                    equal_shifts<20>);
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, bucket_sort_splice_bucket_of) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test) {
+          // Two values per bucket, descending like the order
+          const auto bucket_of = [](const int x) { return (7 - x) / 2; };
+          if (i % 2)
+            return bucket_sort_splice<4>(this->range, left, right,
+                                         bucket_of, &test_type::value,
+                                         std::greater{}, &test_type::value);
+          return bucket_sort_splice<4>(std::allocator<int>{},
+                                       this->range, left, right,
+                                       bucket_of, &test_type::value,
+                                       std::greater{}, &test_type::value);
+        }
+        else {
+          const auto bucket_of = [](const int x) { return x >> 22; };
+          if (i % 2)
+            return bucket_sort_splice<512>(this->range, left, right,
+                                           bucket_of);
+          return bucket_sort_splice<512>(std::allocator<int>{},
+                                         this->range, left, right,
+                                         bucket_of);
+        }
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, bucket_sort_splice_three_way) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test) {
+          // Two values per bucket, descending like the order
+          const auto cmp = [](const int x, const int y) {
+            return (7 - x) / 2 <=> (7 - y) / 2;
+          };
+          if (i % 2)
+            return bucket_sort_splice<4>(this->range, left, right,
+                                         cmp, &test_type::value,
+                                         std::greater{}, &test_type::value);
+          return bucket_sort_splice<2>(merging_bucket_sort_policy<>{},
+                                       this->range, left, right,
+                                       cmp, &test_type::value,
+                                       std::greater{}, &test_type::value);
+        }
+        else {
+          // More classes than buckets, so the last one gets dirty
+          const auto key = [](const int x) { return x >> 22; };
+          if (i % 2)
+            return bucket_sort_splice(this->range, left, right,
+                                      std::compare_three_way{}, key);
+          return bucket_sort_splice<512>(merging_bucket_sort_policy<>{},
+                                         this->range, left, right,
+                                         std::compare_three_way{}, key);
+        }
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, bottom_up_merge_sort_splice) {
+  constexpr size_t Runs = 100;
+  constexpr size_t MaxElts = 1000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [this](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return merge_sort_splice(this->range, left, right,
+                                   std::greater{}, &test_type::value);
+        else
+          return merge_sort_splice(this->range, left, right);
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+
+  if constexpr (!ranges::sized_range<TypeParam>) {
+    // The whole range version for ranges of unknown size
+    this->build_test_vec(MaxElts);
+    this->build_range();
+
+    const auto call_sort = [this]() {
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        return merge_sort_splice(this->range,
+                                 std::greater{}, &test_type::value);
+      else
+        return merge_sort_splice(this->range);
+    };
+
+    const auto last = call_sort();
+    this->test_sorted(last, this->test_vec.begin(), this->test_vec.end());
+
+    this->range = TypeParam{};
+    EXPECT_EQ(call_sort(), ranges::end(this->range));
+  }
+}
+
+TYPED_TEST(SortingTests, natural_merge_sort_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+
+  using value_t = typename TypeParam::value_type;
+  const auto sort_chunk = [](const auto begin, const auto end,
+                             const bool reverse) {
+    const auto less = [](const value_t& lhs, const value_t& rhs) {
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        return lhs.value > rhs.value;
+      else
+        return lhs < rhs;
+    };
+
+    if (reverse)
+      ranges::stable_sort(begin, end, [&less](const auto& l, const auto& r) {
+        return less(r, l);
+      });
+    else
+      ranges::stable_sort(begin, end, less);
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto test_begin = this->test_vec.begin() + skip_left;
+
+    // Make some (ascending or descending) runs in the data
+    if (i % 4 != 0) {
+      const size_t runs = 1 + rand() % 8;
+      for (size_t j = 0; j < runs; ++j) {
+        const auto chunk_begin = test_begin + size * j / runs;
+        const auto chunk_end = test_begin + size * (j + 1) / runs;
+        if (rand() % 4 != 0) sort_chunk(chunk_begin, chunk_end, rand() % 2);
+      }
+      this->build_range();
+    }
+
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [this](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return natural_merge_sort_splice(this->range, left, right,
+                                           std::greater{}, &test_type::value);
+        else
+          return natural_merge_sort_splice(this->range, left, right);
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, test_begin, this->test_vec.end() - skip_right);
+  }
+}
+
+template <typename T, size_t _radix_bits, bool _msd = false>
+auto call_rs(T& range, const size_t skip_left,
+             const size_t size, const size_t skip_right) {
+  const auto sort = [](auto&&... args) {
+    if constexpr (_msd)
+      return msd_radix_sort_splice<_radix_bits>(args...);
+    else
+      return radix_sort_splice<_radix_bits>(args...);
+  };
+
+  return invoke_with_limits(range, skip_left, size, skip_right,
+                            [&range, &sort](const auto left,
+                                            const auto right) {
+    if constexpr (SortingTests<T>::is_stability_test)
+      // Negate the keys to get the same order as the other tests
+      return sort(range, left, right, [](const test_type& x) {
+        return -x.value;
+      });
+    else
+      return sort(std::allocator<int>{}, range, left, right);
+  });
+}
+
+TYPED_TEST(SortingTests, radix_sort_splice) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 1000;
+
+  const std::vector<decltype(&call_rs<TypeParam, 1>)> sorters = {
+    &call_rs<TypeParam, 1>, &call_rs<TypeParam, 5>,
+    &call_rs<TypeParam, 8>, &call_rs<TypeParam, 12>
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      sorters[i % sorters.size()](this->range, skip_left, size, skip_right);
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, msd_radix_sort_splice) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 3000;
+
+  const std::vector<decltype(&call_rs<TypeParam, 1, true>)> sorters = {
+    &call_rs<TypeParam, 1, true>, &call_rs<TypeParam, 3, true>,
+    &call_rs<TypeParam, 8, true>
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      sorters[i % sorters.size()](this->range, skip_left, size, skip_right);
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+enum class test_level: uint8_t {};
+
+TYPED_TEST(SortingTests, counting_sort_splice) {
+  constexpr size_t Runs = 200;
+  constexpr size_t MaxElts = 1000;
+  constexpr size_t Domain = 50;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+    if constexpr (!SortingTests<TypeParam>::is_stability_test) {
+      for (auto& value : this->test_vec) value%= Domain;
+      this->build_range();
+
+      // Also sort the whole range sometimes
+      if (i % 4 == 0) skip_left = skip_right = 0;
+    }
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test) {
+          if (i % 2)
+            return counting_sort_splice<8>(this->range, left, right,
+                                           [](const test_type& x) {
+              return 7 - x.value;
+            });
+          return counting_sort_splice<8>(this->range, left, right,
+                                         [](const test_type& x) {
+            return test_level(7 - x.value);
+          });
+        }
+        else {
+          if (skip_left + skip_right == 0)
+            return counting_sort_splice<Domain>(this->range);
+          return counting_sort_splice<Domain>(this->range, left, right);
+        }
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, partial_sort_splice) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 2000;
+
+  using value_t = typename TypeParam::value_type;
+  const auto less = [](const value_t& lhs, const value_t& rhs) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      return lhs.value > rhs.value;
+    else
+      return lhs < rhs;
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const size_t k = i % 3 == 0 ? rand() % 10 : rand() % (size + 2);
+
+    const auto kth =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [this, size, k, i](const auto left, const auto) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return partial_sort_splice(this->range, left, size, k,
+                                     std::greater{}, &test_type::value);
+        else if (i % 2)
+          return partial_sort_splice(this->range, left, size, k);
+        else
+          return partial_sort_splice(prefetching_sort_policy<>{},
+                                     this->range, left, size, k);
+      });
+
+    const size_t sorted = std::min(k, size);
+    EXPECT_EQ(kth, ranges::next(ranges::begin(this->range),
+                                skip_left + (sorted > 0 ? sorted - 1 : 0)));
+
+    const auto test_begin = this->test_vec.begin() + skip_left;
+    const auto test_end = test_begin + size;
+    ranges::stable_sort(test_begin, test_end, less);
+
+    std::vector<value_t> result(ranges::begin(this->range),
+                                ranges::end(this->range));
+    const auto result_begin = result.begin() + skip_left;
+    const auto result_end = result_begin + size;
+
+    // The first k are the same as after the stable sort, the rest of
+    // the elements are just the same
+    ASSERT_TRUE(ranges::equal(result_begin, result_begin + sorted,
+                              test_begin, test_begin + sorted));
+    const auto total_less = [](const value_t& lhs, const value_t& rhs) {
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        return std::tie(lhs.value, lhs.count) < std::tie(rhs.value, rhs.count);
+      else
+        return lhs < rhs;
+    };
+    ranges::sort(result_begin + sorted, result_end, total_less);
+    ranges::sort(test_begin + sorted, test_end, total_less);
+    ASSERT_TRUE(ranges::equal(result_begin + sorted, result_end,
+                              test_begin + sorted, test_end));
+    ASSERT_TRUE(ranges::equal(result.begin(), result_begin,
+                              this->test_vec.begin(), test_begin));
+    ASSERT_TRUE(ranges::equal(result_end, result.end(),
+                              test_end, this->test_vec.end()));
+  }
+}
+
+TYPED_TEST(SortingTests, nth_element_splice) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 2000;
+
+  using value_t = typename TypeParam::value_type;
+  const auto less = [](const value_t& lhs, const value_t& rhs) {
+    if constexpr (SortingTests<TypeParam>::is_stability_test)
+      return lhs.value > rhs.value;
+    else
+      return lhs < rhs;
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto test_begin = this->test_vec.begin() + skip_left;
+    const auto test_end = test_begin + size;
+
+    // Also try the sorted and the reversed inputs
+    if (i % 4 == 1) ranges::stable_sort(test_begin, test_end, less);
+    else if (i % 4 == 2)
+      ranges::stable_sort(test_begin, test_end, [&less](const auto& lhs,
+                                                        const auto& rhs) {
+        return less(rhs, lhs);
+      });
+    this->build_range();
+
+    const size_t n = rand() % size;
+    const auto nth =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [this, size, n, i](const auto left, const auto) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return nth_element_splice(this->range, left, size, n,
+                                    std::greater{}, &test_type::value);
+        else if (i % 2)
+          return nth_element_splice(this->range, left, size, n);
+        else
+          return nth_element_splice(prefetching_sort_policy<>{},
+                                    this->range, left, size, n);
+      });
+
+    EXPECT_EQ(nth, ranges::next(ranges::begin(this->range), skip_left + n));
+
+    std::vector<value_t> result(ranges::begin(this->range),
+                                ranges::end(this->range));
+    const auto result_begin = result.begin() + skip_left;
+    const auto result_end = result_begin + size;
+    const auto result_nth = result_begin + n;
+
+    ASSERT_TRUE(ranges::all_of(result_begin, result_nth,
+                               [&](const auto& x) {
+                                 return !less(*result_nth, x);
+                               }));
+    ASSERT_TRUE(ranges::all_of(result_nth, result_end,
+                               [&](const auto& x) {
+                                 return !less(x, *result_nth);
+                               }));
+
+    // The n-th element is the same as after the stable sort, and the
+    // rest of the elements are just the same
+    ranges::stable_sort(test_begin, test_end, less);
+    EXPECT_EQ(*result_nth, *(test_begin + n));
+
+    const auto total_less = [](const value_t& lhs, const value_t& rhs) {
+      if constexpr (SortingTests<TypeParam>::is_stability_test)
+        return std::tie(lhs.value, lhs.count) < std::tie(rhs.value, rhs.count);
+      else
+        return lhs < rhs;
+    };
+    ranges::sort(result_begin, result_end, total_less);
+    ranges::sort(test_begin, test_end, total_less);
+    ASSERT_TRUE(ranges::equal(result_begin, result_end,
+                              test_begin, test_end));
+    ASSERT_TRUE(ranges::equal(result.begin(), result_begin,
+                              this->test_vec.begin(), test_begin));
+    ASSERT_TRUE(ranges::equal(result_end, result.end(),
+                              test_end, this->test_vec.end()));
+  }
+}
+
+TYPED_TEST(SortingTests, buffered_sort_splice) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 3000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [this, i](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return buffered_sort_splice(std::allocator<int>{}, this->range,
+                                      left, right,
+                                      std::greater{}, &test_type::value);
+        else if (i % 2)
+          return buffered_sort_splice(std::allocator<int>{}, this->range,
+                                      left, right);
+        else
+          return buffered_sort_splice(prefetching_sort_policy<>{},
+                                      std::allocator<int>{}, this->range,
+                                      left, right);
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+template <typename T>
+auto call_with_policy(const auto& policy, T& range, const size_t idx,
+                      const size_t skip_left, const size_t size,
+                      const size_t skip_right) {
+  // Only use the sorting algorithms on the interval with the given
+  // sort policy and turn the result into a (size, last) pair
+  return invoke_with_limits(range, skip_left, size, skip_right,
+                            [&](const auto left, const auto right) {
+    const auto call = [&](const auto comp, const auto proj)
+      -> std::pair<size_t, ranges::iterator_t<T>> {
+      switch (idx) {
+      case 0:
+        return { size, insertion_sort_splice(policy, range, left, size,
+                                             comp, proj) };
+      case 1:
+        return { size, merge_sort_splice(policy, range, left, size,
+                                         comp, proj) };
+      case 2:
+        return merge_sort_splice(policy, range, left, right, comp, proj);
+      case 3:
+        return natural_merge_sort_splice(policy, range, left, right,
+                                         comp, proj);
+      case 4:
+        return bucket_sort_splice<8>(policy, range, left, right,
+                                     equal_shifts<0>, proj, comp, proj);
+      default:
+        return bucket_sort_splice<8>(policy, std::allocator<int>{},
+                                     range, left, right,
+                                     equal_shifts<0>, proj, comp, proj);
+      };
+    };
+
+    if constexpr (SortingTests<T>::is_stability_test)
+      return call(std::greater{}, &test_type::value);
+    else
+      return call(ranges::less{}, std::identity{});
+  });
+}
+
+TYPED_TEST(SortingTests, prefetching_sort_policy) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 1000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] =
+      call_with_policy(prefetching_sort_policy<>{}, this->range, i % 6,
+                       skip_left, size, skip_right);
 
-    this->test_sorted(result, this->test_vec.begin() + skip_left,
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
                       this->test_vec.end() - skip_right);
   }
 }
 
-TYPED_TEST(SortingTests, merge_sort_splice) {
-  constexpr size_t Runs = 100;
+TYPED_TEST(SortingTests, galloping_sort_policy) {
+  constexpr size_t Runs = 300;
   constexpr size_t MaxElts = 1000;
 
   for (size_t i = 0; i < Runs; ++i) {
     auto [skip_left, skip_right] =
       this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
 
-    ranges::iterator_t<TypeParam> result;
-    if (skip_left == 0) {
-      const auto count = this->test_vec.size() - skip_right;
-      if constexpr (SortingTests<TypeParam>::is_stability_test)
-        result =
-          merge_sort_splice(this->range, before_begin(this->range), count,
-                            std::greater{}, &test_type::value);
-      else
-        result =
-          merge_sort_splice(this->range, before_begin(this->range), count);
+    // Long runs of equal elements make the merges gallop a lot
+    if constexpr (!SortingTests<TypeParam>::is_stability_test)
+      if (i % 2)
+        for (auto& x : this->test_vec) x%= 1 + rand() % 16;
+    this->build_range();
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] = i % 3
+      ? call_with_policy(galloping_sort_policy<>{}, this->range, i % 6,
+                         skip_left, size, skip_right)
+      : call_with_policy(galloping_sort_policy
+                         <prefetching_sort_policy<>, 1>{},
+                         this->range, i % 6, skip_left, size, skip_right);
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, network_sort_policy) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 1000;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    // Small sizes too, so that there are incomplete leaves
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : i % 4 ? MaxElts : 40);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto call = [&](const auto& policy) {
+      return call_with_policy(policy, this->range, 1 + i % 5,
+                              skip_left, size, skip_right);
+    };
+
+    std::pair<size_t, ranges::iterator_t<TypeParam>> result;
+    switch (i % 4) {
+    case 0: result = call(network_sort_policy<>{}); break;
+    case 1: result = call(network_sort_policy<default_sort_policy, 2>{});
+      break;
+    case 2: result = call(network_sort_policy<default_sort_policy, 16>{});
+      break;
+    default:
+      result = call(network_sort_policy<prefetching_sort_policy<>, 32>{});
     }
-    else {
-      const auto left = ranges::next(ranges::begin(this->range), skip_left - 1);
-      const auto count = this->test_vec.size() - skip_left - skip_right;
-      if constexpr (SortingTests<TypeParam>::is_stability_test)
-        result = merge_sort_splice(this->range, left, count,
-                                   std::greater{}, &test_type::value);
-      else
-        result = merge_sort_splice(this->range, left, count);
+
+    EXPECT_EQ(result.first, size);
+    this->test_sorted(result.second, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
+
+TYPED_TEST(SortingTests, merging_bucket_sort_policy) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 1000;
+
+  // Few buckets for many classes, so that they are merged a lot
+  constexpr size_t BucketCounts[] = { 1, 2, 3, 5, 40 };
+  const merging_bucket_sort_policy<> policy;
+
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    if (i % 3 == 0) {
+      // Every element is a class of its own
+      const auto [out_size, last] =
+        call_with_policy(policy, this->range, 4 + i % 2,
+                         skip_left, size, skip_right);
+
+      EXPECT_EQ(out_size, size);
+      this->test_sorted(last, this->test_vec.begin() + skip_left,
+                        this->test_vec.end() - skip_right);
+      continue;
     }
 
-    this->test_sorted(result, this->test_vec.begin() + skip_left,
+    const size_t max_buckets = BucketCounts[i % std::size(BucketCounts)];
+    const auto [out_size, last] =
+      invoke_with_limits(this->range, skip_left, size, skip_right,
+                         [&](const auto left, const auto right) {
+        if constexpr (SortingTests<TypeParam>::is_stability_test)
+          return bucket_sort_splice(policy, max_buckets,
+                                    std::allocator<int>{}, this->range,
+                                    left, right,
+                                    equal_shifts<1>, &test_type::value,
+                                    std::greater{}, &test_type::value);
+        else
+          return bucket_sort_splice(policy, max_buckets,
+                                    std::allocator<int>{}, this->range,
+                                    left, right, equal_shifts<22>);
+      });
+
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
                       this->test_vec.end() - skip_right);
   }
 }
 
-TEST(FlatListTests, base) {
-  // Test an internal structure used in sorting
-  constexpr size_t MaxElts = 100;
+TYPED_TEST(SortingTests, key_caching_sort_policy) {
+  constexpr size_t Runs = 300;
+  constexpr size_t MaxElts = 1000;
 
-  __detail::flat_list<size_t, MaxElts> list;
-  std::forward_list<size_t> test_list;
+  for (size_t i = 0; i < Runs; ++i) {
+    auto [skip_left, skip_right] =
+      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
 
-  static_assert(ranges::forward_range<decltype(list)>);
-  ASSERT_EQ(sizeof(decltype(list)::pos_t), 1);
+    const auto size = this->test_vec.size() - skip_left - skip_right;
+    const auto [out_size, last] = i % 3
+      ? call_with_policy(key_caching_sort_policy<>{}, this->range, i % 6,
+                         skip_left, size, skip_right)
+      : call_with_policy(key_caching_sort_policy
+                         <merging_bucket_sort_policy<>>{},
+                         this->range, i % 6, skip_left, size, skip_right);
 
-  for (size_t i = 0; i < MaxElts; ++i) {
-    EXPECT_EQ(list.size(), i);
+    EXPECT_EQ(out_size, size);
+    this->test_sorted(last, this->test_vec.begin() + skip_left,
+                      this->test_vec.end() - skip_right);
+  }
+}
 
-    const auto des = rand() % 3;
-    const auto pos = des == 0 ? 0 : (des == 1 ? i : (rand() % (i + 1)));
-    const auto it =
-      list.emplace_after(ranges::next(list.before_begin(), pos), i);
+TEST(SortingPolicyTests, merging_buckets) {
+  constexpr int RareClasses = 200;
+  constexpr int DenseClasses = 8;
+  constexpr size_t DenseElts = 20000;
+
+  // A tail of rare classes takes all the buckets before the dense
+  // classes show up
+  std::vector<int> test_vec;
+  for (int i = 0; i < RareClasses; ++i)
+    test_vec.push_back((DenseClasses + i) << 10);
+  for (size_t i = 0; i < DenseElts; ++i)
+    test_vec.push_back((rand() % DenseClasses) << 10 | rand() % 1024);
+
+  std::array<sort_stats, 2> stats;
+  for (const bool merge : {false, true}) {
+    std::forward_list<int> list(test_vec.begin(), test_vec.end());
+    const auto [size, last] = merge
+      ? bucket_sort_splice<8>(stats_sort_policy
+                              <merging_bucket_sort_policy<>>{stats[1]},
+                              list, list.before_begin(), list.end(),
+                              equal_shifts<10>)
+      : bucket_sort_splice<8>(stats_sort_policy<>{stats[0]},
+                              list, list.before_begin(), list.end(),
+                              equal_shifts<10>);
+
+    EXPECT_EQ(size, test_vec.size());
+    EXPECT_EQ(*last, ranges::max(test_vec));
+    EXPECT_TRUE(ranges::is_sorted(list));
+  }
 
-    EXPECT_EQ(*it, i);
-    EXPECT_EQ(ranges::next(list.before_begin()), list.begin());
-    EXPECT_EQ(ranges::next(list.begin(), list.size()), list.end());
+  EXPECT_EQ(stats[0].dirty_bucket_merges, 1);
+  EXPECT_EQ(stats[1].dirty_bucket_merges, 0);
+  EXPECT_EQ(stats[1].bucket_overflows, 0);
+  EXPECT_GT(stats[1].bucket_merges, 0);
+  EXPECT_LT(stats[1].comparisons, stats[0].comparisons);
+}
 
-    test_list.emplace_after(ranges::next(test_list.before_begin(), pos), i);
+TEST(SortingPolicyTests, key_caching) {
+  constexpr size_t Elts = 5000;
 
-    size_t ctr = 0;
-    auto test_it = test_list.begin();
-    for (auto x : list) {
-      ++ctr;
-      ASSERT_EQ(x, *test_it++);
+  std::vector<std::string> test_vec(Elts);
+  for (auto& x : test_vec) x = std::to_string(rand() % 1000);
+
+  size_t calls = 0;
+  const auto proj = [&calls](const std::string& x) {
+    ++calls;
+    return std::stoi(x);
+  };
+  const auto bucket_of = [&calls](const int x) {
+    ++calls;
+    return size_t(x / 100);
+  };
+  const key_caching_sort_policy<> policy;
+
+  auto sorted = test_vec;
+  ranges::stable_sort(sorted, {}, proj);
+
+  for (size_t i = 0; i < 4; ++i) {
+    std::forward_list<std::string> list(test_vec.begin(), test_vec.end());
+    calls = 0;
+
+    size_t size = Elts;
+    switch (i) {
+    case 0:
+      merge_sort_splice(policy, list, list.before_begin(), Elts, {}, proj);
+      break;
+    case 1:
+      size = merge_sort_splice(policy, list, list.before_begin(), list.end(),
+                               {}, proj).first;
+      break;
+    case 2:
+      size = bucket_sort_splice<16>(policy, list,
+                                    list.before_begin(), list.end(),
+                                    equal_shifts<0>, proj,
+                                    ranges::less{}, proj).first;
+      break;
+    default:
+      size = bucket_sort_splice<10>(policy, list,
+                                    list.before_begin(), list.end(),
+                                    bucket_of, proj,
+                                    ranges::less{}, proj).first;
     }
 
-    EXPECT_EQ(ctr, (i + 1));
+    // Every projection (and bucket_of) is called once per element
+    EXPECT_EQ(size, Elts);
+    EXPECT_EQ(calls, (i < 2 ? 1 : i == 2 ? 2 : 3) * Elts);
+    EXPECT_TRUE(ranges::equal(list, sorted));
   }
 }
 
-template <size_t _shift>
-bool equal_shifts(const int x, const int y) noexcept {
-  return x >> _shift == y >> _shift;
+TEST(SortingPolicyTests, galloping_comparisons) {
+  constexpr int RunLength = 1000;
+  constexpr int Runs = 16;
+
+  // Interleaving blocks of consecutive numbers
+  std::vector<int> lhs, rhs;
+  for (int i = 0; i < RunLength * Runs; ++i)
+    (i / RunLength % 2 ? rhs : lhs).push_back(i);
+
+  for (const bool gallop : {false, true}) {
+    std::forward_list<int> list(lhs.begin(), lhs.end());
+    auto mid = list.before_begin();
+    for (auto it = list.begin(); it != list.end(); ++it) mid = it;
+    auto last = mid;
+    for (const int x : rhs) last = list.insert_after(last, x);
+
+    size_t comparisons = 0;
+    const auto comp = [&comparisons](const int x, const int y) {
+      ++comparisons;
+      return x < y;
+    };
+
+    const auto result = gallop
+      ? coinplace_merge_splice(galloping_sort_policy<>{}, list,
+                               list.before_begin(), mid, last, comp)
+      : coinplace_merge_splice(list, list.before_begin(), mid, last, comp);
+
+    EXPECT_EQ(*result, RunLength * Runs - 1);
+    EXPECT_TRUE(ranges::is_sorted(list));
+    if (gallop) {
+      EXPECT_LT(comparisons, size_t(Runs * 64));
+    }
+    else {
+      EXPECT_GE(comparisons, size_t(RunLength * (Runs - 2)));
+    }
+  }
 }
 
-template <typename T, size_t _max_buckets = 1, size_t _shift = 0>
-auto call_bs(T& range, const size_t skip_left,
-             const size_t size, const size_t skip_right) {
-  const auto invoker = [&range](const auto left, const auto right) {
-    if constexpr (SortingTests<T>::is_stability_test)
-      return bucket_sort_splice<_max_buckets>
-        (range, left, right, equal_shifts<_shift>, &test_type::value,
-         std::greater{}, &test_type::value);
-    else
-      return bucket_sort_splice<_max_buckets>(range, left, right,
-                                              equal_shifts<_shift>);
+TEST(SortingPolicyTests, three_way_comparisons) {
+  constexpr size_t Elts = 20000;
+
+  std::vector<int> test_vec(Elts);
+  ranges::generate(test_vec, []() { return rand(); });
+
+  const auto sort = [&test_vec](const auto policy, const bool three_way) {
+    std::forward_list<int> list(test_vec.begin(), test_vec.end());
+    const auto [size, last] = three_way
+      ? bucket_sort_splice<16>(policy, list,
+                               list.before_begin(), list.end(),
+                               std::compare_three_way{},
+                               [](const int x) { return x >> 25; })
+      : bucket_sort_splice<16>(policy, list,
+                               list.before_begin(), list.end(),
+                               equal_shifts<25>);
+
+    EXPECT_EQ(size, test_vec.size());
+    EXPECT_EQ(*last, ranges::max(test_vec));
+    EXPECT_TRUE(ranges::is_sorted(list));
   };
 
-  if (skip_left == 0) {
-    if (skip_right == 0)
-      return invoker(before_begin(range), ranges::end(range));
-    else
-      return invoker(before_begin(range),
-                     ranges::next(ranges::begin(range), skip_left + size));
+  // The same buckets, found with one call per step instead of two
+  for (const bool merge : {false, true}) {
+    std::array<sort_stats, 2> stats;
+    for (const bool three_way : {false, true}) {
+      if (merge)
+        sort(stats_sort_policy<merging_bucket_sort_policy<>>
+               {stats[three_way]}, three_way);
+      else
+        sort(stats_sort_policy<>{stats[three_way]}, three_way);
+    }
+
+    EXPECT_EQ(stats[0].buckets, stats[1].buckets);
+    EXPECT_EQ(stats[0].bucket_merges, stats[1].bucket_merges);
+    EXPECT_LT(stats[1].comparisons, stats[0].comparisons);
+    if (merge) {
+      EXPECT_GT(stats[1].bucket_merges, 0);
+    }
   }
-  else {
-    const auto llim = ranges::next(ranges::begin(range), skip_left - 1);
-    if (skip_right == 0)
-      return invoker(llim, ranges::end(range));
-    else
-      return invoker(llim,
-                     ranges::next(ranges::begin(range), skip_left + size));
+}
+
+TEST(SortingPolicyTests, sort_stats) {
+  constexpr size_t Elts = 1000;
+
+  for (size_t i = 0; i < 6; ++i) {
+    std::list<int> list(Elts);
+    ranges::generate(list, []() { return rand() % 100; });
+
+    sort_stats stats;
+    const auto [size, last] =
+      call_with_policy(stats_sort_policy<>{stats}, list, i, 0, Elts, 0);
+
+    EXPECT_EQ(size, Elts);
+    EXPECT_EQ(*last, ranges::max(list));
+    EXPECT_TRUE(ranges::is_sorted(list));
+
+    EXPECT_GT(stats.comparisons, 0);
+    EXPECT_GT(stats.splices, 0);
+    EXPECT_GE(stats.traversed, Elts - 1);
+    EXPECT_EQ(stats.depth, 0);
+    if (i == 0) {
+      // Insertion sort moves the elements one at a time, at most once
+      EXPECT_EQ(stats.runs, 0);
+      EXPECT_EQ(stats.max_depth, 0);
+      EXPECT_LT(stats.splices, Elts);
+    }
+    else if (i < 4) {
+      EXPECT_GT(stats.runs, 1);
+      EXPECT_GT(stats.max_depth, 1);
+    }
+    else {
+      EXPECT_EQ(stats.buckets, 8);
+      EXPECT_GT(stats.bucket_overflows, 0);
+      EXPECT_EQ(stats.dirty_bucket_merges, 1);
+    }
+  }
+
+  // The comparator calls are counted exactly, and the counters add up
+  std::forward_list<int> list(Elts);
+  ranges::generate(list, []() { return rand(); });
+
+  size_t comparisons = 0;
+  const auto comp = [&comparisons](const int x, const int y) {
+    ++comparisons;
+    return x < y;
+  };
+
+  sort_stats stats;
+  merge_sort_splice(stats_sort_policy<galloping_sort_policy<>>{stats},
+                    list, list.before_begin(), Elts, comp);
+  merge_sort_splice(stats_sort_policy<>{stats},
+                    list, list.before_begin(), Elts, comp);
+  EXPECT_EQ(stats.comparisons, comparisons);
+  EXPECT_TRUE(ranges::is_sorted(list));
+
+  // The selection algorithms and the merges count them as well
+  for (size_t i = 0; i < 4; ++i) {
+    ranges::generate(list, []() { return rand(); });
+    comparisons = 0;
+    stats = sort_stats{};
+
+    const stats_sort_policy<> policy{stats};
+    switch (i) {
+    case 0:
+      partial_sort_splice(policy, list, list.before_begin(), Elts, 10, comp);
+      break;
+    case 1:
+      nth_element_splice(policy, list, list.before_begin(), Elts, 10, comp);
+      break;
+    case 2:
+      quick_sort_splice(policy, list, list.before_begin(), Elts, comp);
+      break;
+    default:
+      std::vector<std::forward_list<int>> srcs(2, list);
+      for (auto& src : srcs) src.sort();
+      list.clear();
+      merge_splice(policy, list, srcs, comp);
+    }
+
+    EXPECT_GT(comparisons, 0);
+    EXPECT_EQ(stats.comparisons, comparisons);
+  }
+
+  // The depth is restored if the comparator throws
+  ranges::generate(list, []() { return rand(); });
+  stats = sort_stats{};
+  size_t calls = 0;
+  EXPECT_THROW(merge_sort_splice(stats_sort_policy<>{stats},
+                                 list, list.before_begin(), Elts,
+                                 [&calls](const int x, const int y) {
+                                   if (++calls == Elts) throw 42;
+                                   return x < y;
+                                 }),
+               int);
+  EXPECT_GT(stats.max_depth, 1);
+  EXPECT_EQ(stats.depth, 0);
+}
+
+// A list with a custom prefetching hook
+class prefetch_counting_list: public std::forward_list<int> {
+public:
+  using std::forward_list<int>::forward_list;
+
+  void prefetch(const iterator it) noexcept {
+    EXPECT_NE(it, end());
+    ++prefetches;
   }
+
+  size_t prefetches = 0;
 };
 
-TYPED_TEST(SortingTests, bucket_sort_splice) {
-  constexpr size_t Runs = 500;
+TEST(SortingPolicyTests, prefetch_hook) {
   constexpr size_t MaxElts = 1000;
 
-  std::vector<decltype(&call_bs<TypeParam>)> sorters;
-  if constexpr (SortingTests<TypeParam>::is_stability_test)
-    sorters = {
-      &call_bs<TypeParam, 4, 1>, // exact match
-      &call_bs<TypeParam, 2, 1>, // less buckets
-      &call_bs<TypeParam, 8, 1>, // too many buckets
-      &call_bs<TypeParam, 3, 3>, // all equiv
-      &call_bs<TypeParam, 8, 0>  // all not equiv
-    };
-  else
-    sorters =  {
-      &call_bs<TypeParam, 32, 26>, // exact match
-      &call_bs<TypeParam, 20, 25>, // less buckets
-      &call_bs<TypeParam, 64, 27>, // too many buckets
-      &call_bs<TypeParam, 16, 31>, // all equiv
-      &call_bs<TypeParam, 8, 0>    // all not equiv
-    };
-
-  for (size_t i = 0; i < Runs; ++i) {
-    auto [skip_left, skip_right] =
-      this->build_all_for_sorting(i == 0 ? 1 : MaxElts);
+  for (size_t i = 0; i < 6; ++i) {
+    prefetch_counting_list list(MaxElts);
+    ranges::generate(list, []() { return rand(); });
 
-    const auto size = this->test_vec.size() - skip_left - skip_right;
-    const auto [out_size, last] =
-      sorters[rand() % sorters.size()](this->range,
-                                       skip_left, size, skip_right);
+    call_with_policy(default_sort_policy{}, list, i, 0, MaxElts, 0);
+    EXPECT_EQ(list.prefetches, 0);
+    EXPECT_TRUE(ranges::is_sorted(list));
 
-    EXPECT_EQ(out_size, size);
-    this->test_sorted(last, this->test_vec.begin() + skip_left,
-                      this->test_vec.end() - skip_right);
+    ranges::generate(list, []() { return rand(); });
+    call_with_policy(prefetching_sort_policy<>{}, list, i, 0, MaxElts, 0);
+    EXPECT_GT(list.prefetches, 0);
+    EXPECT_TRUE(ranges::is_sorted(list));
   }
 }
 
@@ -352,11 +1809,21 @@ TEST_F(SortingListTests, alt_interfaces) {
     case 3: return test_bucket_sort(bucket_sort_splice(std::allocator<int>{},
                                                        this->range,
                                                        equal_shifts<26>));
+    case 4: return natural_merge_sort_splice(this->range);
+    case 5: return partial_sort_splice(this->range, 1000);
+    case 6: return quick_sort_splice(this->range);
+    case 7: return test_bucket_sort(bucket_sort_splice<32>
+                                      (this->range, [](const int x) {
+                                        return x >> 26;
+                                      }));
+    case 8: return test_bucket_sort(bucket_sort_splice
+                                      (this->range, std::compare_three_way{},
+                                       [](const int x) { return x >> 26; }));
     default: return std::list<int>::iterator{};
     };
   };
 
-  for (size_t i = 0; i < 4; ++i) {
+  for (size_t i = 0; i < 9; ++i) {
     this->build_test_vec(100);
     this->build_range();
 
@@ -370,6 +1837,117 @@ TEST_F(SortingListTests, alt_interfaces) {
   }
 }
 
+TEST_F(SortingListTests, radix_sort_keys) {
+  constexpr size_t Runs = 50;
+  constexpr size_t MaxElts = 2000;
+
+  // Test different key types, including the signed ones and the ones
+  // with constant digits
+  const auto test_keys = [this](const auto proj) {
+    for (const bool msd : { false, true }) {
+      this->build_test_vec(1 + rand() % MaxElts);
+      this->build_range();
+
+      const auto [out_size, last] = msd
+        ? msd_radix_sort_splice(this->range, proj)
+        : radix_sort_splice(this->range, proj);
+      EXPECT_EQ(out_size, this->test_vec.size());
+
+      ranges::stable_sort(this->test_vec, {}, proj);
+      EXPECT_EQ(*last, this->test_vec.back());
+      EXPECT_TRUE(ranges::equal(this->range, this->test_vec));
+    }
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    test_keys([](const int x) { return x - (1 << 30); });
+    test_keys([](const int x) { return int8_t(x); });
+    test_keys([](const int x) { return int64_t(x % 5) * -(int64_t{1} << 40); });
+    test_keys([](const int x) { return uint16_t(x & 0xF0F0); });
+    test_keys([](const int) { return 42u; });
+    test_keys([](const int x) {
+      return (uint64_t(x % 3) << 60) | (uint64_t(x % 7) << 30) | (x & 0xFF);
+    });
+  }
+
+  this->range.clear();
+  const auto [out_size, last] = radix_sort_splice(this->range);
+  EXPECT_EQ(out_size, 0);
+  EXPECT_EQ(last, ranges::end(this->range));
+
+  const auto [msd_size, msd_last] =
+    msd_radix_sort_splice(std::allocator<int>{}, this->range);
+  EXPECT_EQ(msd_size, 0);
+  EXPECT_EQ(msd_last, ranges::end(this->range));
+}
+
+TEST_F(SortingListTests, nth_element_median) {
+  constexpr size_t Elts = 10001;
+
+  // Many equivalent elements
+  this->build_test_vec(Elts);
+  ranges::for_each(this->test_vec, [](int& x) { x%= 10; });
+  this->build_range();
+
+  const auto median = nth_element_splice(this->range, Elts / 2);
+  ranges::nth_element(this->test_vec, this->test_vec.begin() + Elts / 2);
+  EXPECT_EQ(*median, this->test_vec[Elts / 2]);
+  EXPECT_EQ(median, ranges::next(ranges::begin(this->range), Elts / 2));
+}
+
+TEST_F(SortingListTests, buffered_sort_keys) {
+  constexpr size_t Runs = 50;
+  constexpr size_t MaxElts = 2000;
+
+  using key_t = std::pair<std::string, int>;
+  std::list<key_t> list;
+  std::vector<key_t> test_vec;
+
+  const auto build = [&](const size_t size) {
+    test_vec.resize(size);
+    for (size_t j = 0; j < size; ++j)
+      test_vec[j] = { std::to_string(rand() % 100), int(j) };
+    list.assign(test_vec.begin(), test_vec.end());
+  };
+
+  for (size_t i = 0; i < Runs; ++i) {
+    build(1 + rand() % MaxElts);
+
+    // The keys are stored by address here
+    auto last = buffered_sort_splice(std::allocator<int>{}, list,
+                                     {}, &key_t::first);
+    ranges::stable_sort(test_vec, {}, &key_t::first);
+    EXPECT_EQ(*last, test_vec.back());
+    EXPECT_TRUE(ranges::equal(list, test_vec));
+
+    // And by value here
+    const auto proj = [](const key_t& x) { return x.first + "!"; };
+    last = buffered_sort_splice(std::allocator<int>{}, list,
+                                std::greater{}, proj);
+    ranges::stable_sort(test_vec, std::greater{}, proj);
+    EXPECT_EQ(*last, test_vec.back());
+    EXPECT_TRUE(ranges::equal(list, test_vec));
+  }
+
+  // The range must be left unchanged if the comparator throws
+  build(MaxElts);
+  size_t calls = 0;
+  EXPECT_THROW(buffered_sort_splice(std::allocator<int>{}, list,
+                                    [&calls](const auto& lhs,
+                                             const auto& rhs) {
+                                      if (++calls > 100) throw 42;
+                                      return lhs < rhs;
+                                    }), int);
+  EXPECT_TRUE(ranges::equal(list, test_vec));
+
+  list.clear();
+  EXPECT_EQ(buffered_sort_splice(std::allocator<int>{}, list), list.end());
+
+  EXPECT_TRUE(prefers_buffered_sort(list, 1 << 20, &key_t::second));
+  EXPECT_FALSE(prefers_buffered_sort(list, 1 << 20, &key_t::first));
+  EXPECT_FALSE(prefers_buffered_sort(list, 42, &key_t::second));
+}
+
 TEST_F(SortingListTests, weakly_consistent_bucket_sort) {
   constexpr size_t Runs = 100;
   constexpr size_t MaxElts = 10000;
@@ -399,6 +1977,48 @@ TEST_F(SortingListTests, weakly_consistent_bucket_sort) {
   }
 }
 
+TEST_F(SortingListTests, weakly_consistent_merging_bucket_sort) {
+  constexpr size_t Runs = 100;
+  constexpr size_t MaxElts = 10000;
+
+  // Every key of the order is shared by two classes of the relation,
+  // so the buckets with equal keys need not be adjacent, yet the
+  // sparse ones still get merged since there are too few buckets
+  const auto comp = [](const int lhs, const int rhs) {
+    return (lhs >> 27) < (rhs >> 27);
+  };
+
+  sort_stats stats;
+  const stats_sort_policy<merging_bucket_sort_policy<>> policy{stats};
+
+  for (size_t i = 0; i < Runs; ++i) {
+    this->build_test_vec(1 + rand() % MaxElts);
+    this->build_range();
+
+    const size_t max_buckets = 2 + i % 4;
+    const auto [out_size, last] = i % 2
+      ? bucket_sort_splice<4>(policy, this->range, before_begin(this->range),
+                              ranges::end(this->range),
+                              equal_shifts<25>, {}, comp)
+      : bucket_sort_splice(policy, max_buckets, std::allocator<int>{},
+                           this->range, before_begin(this->range),
+                           ranges::end(this->range),
+                           equal_shifts<25>, {}, comp);
+
+    EXPECT_EQ(out_size, this->test_vec.size());
+    EXPECT_EQ(ranges::next(last), ranges::end(this->range));
+    ASSERT_TRUE(ranges::is_sorted(this->range, comp));
+
+    std::vector<int> sorted(ranges::begin(this->range),
+                            ranges::end(this->range));
+    ranges::sort(sorted);
+    ranges::sort(this->test_vec);
+    ASSERT_EQ(sorted, this->test_vec);
+  }
+
+  EXPECT_GT(stats.bucket_merges, 0);
+}
+
 struct alloc_stats {
   size_t allocated = 0;
   size_t freed = 0;
@@ -464,4 +2084,57 @@ TEST_F(SortingListTests, bucket_sort_memory) {
   }
   catch (int) {}
   test_stats(65536, 4);
+
+  // The runtime bucket counts: small ones are kept on the stack
+  stats = alloc_stats{};
+  bucket_sort_splice(32, alloc, this->range, equal_shifts<26>);
+  EXPECT_EQ(stats.allocated, 0);
+
+  bucket_sort_splice(1000, alloc, this->range, equal_shifts<11>);
+  test_stats(1000, sizeof(size_t));
+}
+
+TEST_F(SortingListTests, key_caching_memory) {
+  constexpr size_t Elts = 1000;
+  // A cached key, its position, its link and its iterator
+  constexpr size_t elt_size = sizeof(std::pair<int, size_t>)
+    + sizeof(size_t) + sizeof(ranges::iterator_t<std::list<int>>);
+
+  alloc_stats stats;
+  counting_allocator<int> alloc(stats);
+  const key_caching_sort_policy<> policy;
+
+  // The size is known, so every buffer is allocated once
+  this->build_test_vec(Elts);
+  this->build_range();
+  auto last = merge_sort_splice(policy, alloc, this->range,
+                                before_begin(this->range), Elts);
+  this->test_sorted(last, this->test_vec.begin(), this->test_vec.end());
+  EXPECT_GE(stats.allocated, Elts * elt_size);
+  EXPECT_LT(stats.allocated, Elts * elt_size * 5 / 4);
+  EXPECT_EQ(stats.freed, stats.allocated);
+
+  stats = alloc_stats{};
+  this->build_test_vec(Elts);
+  this->build_range();
+  const auto [size, bucket_last] =
+    bucket_sort_splice<16>(policy, alloc, this->range,
+                           before_begin(this->range),
+                           ranges::end(this->range),
+                           std::compare_three_way{},
+                           [](const int x) { return x >> 27; });
+  EXPECT_EQ(size, Elts);
+  this->test_sorted(bucket_last, this->test_vec.begin(),
+                    this->test_vec.end());
+  EXPECT_GE(stats.allocated, Elts * elt_size);
+  EXPECT_EQ(stats.freed, stats.allocated);
+
+  // Without caching, the allocator is not used
+  stats = alloc_stats{};
+  this->build_test_vec(Elts);
+  this->build_range();
+  last = merge_sort_splice(default_sort_policy{}, alloc, this->range,
+                           before_begin(this->range), Elts);
+  this->test_sorted(last, this->test_vec.begin(), this->test_vec.end());
+  EXPECT_EQ(stats.allocated, 0);
 }